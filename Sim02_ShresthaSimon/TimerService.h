@@ -0,0 +1,57 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file TimerService.h
+ *
+ * @brief header for shared timer service class
+ *
+ * @details one thread waits on a timerfd for every sleeping thread in the program. Deadlines are
+ *          kept in a min heap and the timerfd is always armed for the earliest one, so a waiting
+ *          thread sleeps on its own condition variable instead of spinning on the clock
+ *
+ */
+#ifndef CS446PROJ2_TIMERSERVICE_H
+#define CS446PROJ2_TIMERSERVICE_H
+
+#include <queue>
+#include <vector>
+#include <chrono>
+#include <pthread.h>
+using namespace std;
+
+class TimerService {
+    public:
+        // the one service shared by every thread, started the first time it is used
+        static TimerService &instance();
+        // blocks the calling thread until the time has passed
+        void sleepFor(chrono::nanoseconds);
+
+    private:
+        struct Waiter {
+            // CLOCK_MONOTONIC nanoseconds the waiter wakes up at
+            long long deadline;
+            bool done;
+            pthread_cond_t wake;
+        };
+        // orders the heap so the earliest deadline is on top
+        struct Later {
+            bool operator()(const Waiter*, const Waiter*) const;
+        };
+
+        TimerService();
+        // body of the service thread
+        static void *serviceThread(void*);
+        // wakes every waiter that is due and arms the timer for the next one
+        void expire();
+        // sets the timerfd to go off at a deadline, 0 turns it off
+        void arm(long long);
+        // current CLOCK_MONOTONIC time in nanoseconds
+        static long long now();
+
+        int timerFd;
+        pthread_mutex_t lock;
+        priority_queue<Waiter*, vector<Waiter*>, Later> waiters;
+};
+
+
+#endif //CS446PROJ2_TIMERSERVICE_H
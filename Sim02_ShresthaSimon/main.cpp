@@ -23,6 +23,7 @@
 
 #include "Config.h"
 #include "MetaData.h"
+#include "TimerService.h"
 using namespace std;
 using namespace std::chrono;
 //
@@ -37,7 +38,6 @@ void lTrim(string& str);
 void rTrim(string& str);
 void Trim(string& str);
 string allocateMemory(int);
-void* timer(void *);
 double threadProcessing(int);
 void processRunner(int, MetaData&);
 //
@@ -126,38 +126,10 @@ int main(int argc, char* argv[]) {
 
     return 0;
 }
-/**
- * @name timer
- *
- * @details timer thread for each process. Calculates duration for each process.
- *
- * @param process
- *        process to calculate time for
- *
- */
-void* timer(void *process){
-    // creating start and end points
-    chrono::system_clock::time_point start;
-    chrono::system_clock::time_point end;
-    // Setting a time limit
-    double timeLimit = 0.1;
-    // time spent variable
-    chrono::duration<double> timeSpent;
-    //starting the timer
-    start = chrono::system_clock::now();
-    // while the time limit is not reached, calculate time
-    while(timeSpent.count() < timeLimit){
-        end = chrono::system_clock::now();
-        timeSpent = end - start;
-    }
-    // delete thread
-    pthread_exit(NULL);
-    return NULL;
-}
 /**
  * @name threadProcessing
  *
- * @description creates threads for timer
+ * @description waits for an operation to finish
  *
  * @param timeLimit
  *        The max length a process is allowed to take
@@ -165,18 +137,8 @@ void* timer(void *process){
  * @return
  */
 double threadProcessing(int timeLimit){
-//    int time = timeLimit;
-    // timerThread variable to track time
-    pthread_t timerThread;
-
-    //the time limit that a process can reach
-    auto timeEnd = chrono::system_clock::now() + chrono::milliseconds(timeLimit);
-
-    //until the max thread is reached, create a new timer thread and add it to the main
-    while(chrono::system_clock::now() < timeEnd){
-        pthread_create(&timerThread, NULL, timer, NULL);
-        pthread_join(timerThread, NULL);
-    }
+    // sleep on the shared timer instead of spinning for the whole operation
+    TimerService::instance().sleepFor(chrono::milliseconds(timeLimit));
     // current time of the thread
     auto currentTime = chrono::system_clock::now();
     // calculating the amount of time a process has taken
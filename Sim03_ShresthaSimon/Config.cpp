@@ -24,6 +24,47 @@ Config::Config() {
 // Destructor Function
 Config::~Config() {
 
+}
+//
+/**
+ * @brief reads the configuration file and freezes it
+ *
+ * @details the returned configuration can not be changed, it is shared by pointer or reference
+ *          instead of being copied for every log line
+ *
+ * @param configFilePath
+ *        the configuration file input
+ *
+ * @return the loaded configuration
+ */
+shared_ptr<const Config> Config::load(string configFilePath) {
+    shared_ptr<Config> conf = make_shared<Config>();
+    conf->readConfigFile(configFilePath);
+    conf->freeze();
+    return conf;
+}
+//
+/**
+ * @brief turns the log option into a log target and opens the log file once
+ */
+void Config::freeze() {
+    if(this->logOption == "Log to Both"){
+        this->logTarget = LOG_TO_BOTH;
+    }else if(this->logOption == "Log to Monitor"){
+        this->logTarget = LOG_TO_MONITOR;
+    }else if(this->logOption == "Log to File"){
+        this->logTarget = LOG_TO_FILE;
+    }else{
+        cerr << "Error! Log to option is not one of the options avalaible." << endl;
+        exit(0);
+    }
+    if(this->logTarget & LOG_TO_FILE){
+        this->logStream = make_shared<ofstream>(this->logFilePath, ofstream::trunc);
+        if(!*this->logStream){
+            cerr << "Error! Can't open Log File " << this->logFilePath << endl;
+            exit(0);
+        }
+    }
 }
 //
 /**
@@ -342,6 +383,14 @@ const string &Config::getLogFilePath() const {
     return logFilePath;
 }
 //
+Config::LogTarget Config::getLogTarget() const {
+    return logTarget;
+}
+//
+ostream *Config::getLogStream() const {
+    return logStream.get();
+}
+//
 // Trim function
 void Config::trim(string& str){
     str.erase(0, str.find_first_not_of(" ")); // erase empty space
@@ -0,0 +1,111 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file TimerService.cpp
+ *
+ * @brief implementation file for shared timer service class
+ *
+ * @details the timerfd uses absolute CLOCK_MONOTONIC times, so re-arming it for a deadline that
+ *          has already passed makes it go off straight away and no wake up is lost
+ *
+ */
+#include <iostream>
+#include <cstdlib>
+#include <cstdint>
+#include <ctime>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+#include "TimerService.h"
+using namespace std;
+
+// creates the timerfd and starts the service thread
+TimerService::TimerService() {
+    this->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if(this->timerFd < 0){
+        cerr << "Error! Could not create timer" << endl;
+        exit(0);
+    }
+    pthread_mutex_init(&this->lock, NULL);
+
+    pthread_t service;
+    pthread_create(&service, NULL, serviceThread, this);
+    pthread_detach(service);
+}
+
+// the service lives until the program exits
+TimerService &TimerService::instance() {
+    static TimerService service;
+    return service;
+}
+
+/**
+ * @details: adds the calling thread to the heap and sleeps until the service wakes it
+ * @param delay
+ *        how long to sleep for
+ */
+void TimerService::sleepFor(chrono::nanoseconds delay) {
+    if(delay.count() <= 0){
+        return;
+    }
+    Waiter waiter;
+    waiter.deadline = now() + delay.count();
+    waiter.done = false;
+    pthread_cond_init(&waiter.wake, NULL);
+
+    pthread_mutex_lock(&this->lock);
+    this->waiters.push(&waiter);
+    // the new deadline is the earliest one, so the timer has to go off sooner
+    if(this->waiters.top() == &waiter){
+        this->arm(waiter.deadline);
+    }
+    while(!waiter.done){
+        pthread_cond_wait(&waiter.wake, &this->lock);
+    }
+    pthread_mutex_unlock(&this->lock);
+    pthread_cond_destroy(&waiter.wake);
+}
+
+// blocks on the timerfd forever, waking waiters each time it goes off
+void *TimerService::serviceThread(void *service) {
+    TimerService *timerService = static_cast<TimerService*>(service);
+    uint64_t expirations;
+    while(true){
+        if(read(timerService->timerFd, &expirations, sizeof(expirations)) != sizeof(expirations)){
+            continue;
+        }
+        timerService->expire();
+    }
+    return NULL;
+}
+
+void TimerService::expire() {
+    pthread_mutex_lock(&this->lock);
+    long long current = now();
+    while(!this->waiters.empty() && this->waiters.top()->deadline <= current){
+        Waiter *waiter = this->waiters.top();
+        this->waiters.pop();
+        waiter->done = true;
+        pthread_cond_signal(&waiter->wake);
+    }
+    this->arm(this->waiters.empty() ? 0 : this->waiters.top()->deadline);
+    pthread_mutex_unlock(&this->lock);
+}
+
+void TimerService::arm(long long deadline) {
+    itimerspec spec = {};
+    spec.it_value.tv_sec = deadline / 1000000000;
+    spec.it_value.tv_nsec = deadline % 1000000000;
+    timerfd_settime(this->timerFd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+long long TimerService::now() {
+    timespec current;
+    clock_gettime(CLOCK_MONOTONIC, &current);
+    return (long long) current.tv_sec * 1000000000 + current.tv_nsec;
+}
+
+// earlier deadlines first
+bool TimerService::Later::operator()(const Waiter *a, const Waiter *b) const {
+    return a->deadline > b->deadline;
+}
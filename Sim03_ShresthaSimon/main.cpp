@@ -24,6 +24,7 @@
 
 #include "Config.h"
 #include "MetaData.h"
+#include "TimerService.h"
 using namespace std;
 using namespace std::chrono;
 //
@@ -31,17 +32,16 @@ using namespace std::chrono;
 bool returnInstructions(string line, vector<string>& mdVector);
 bool parseInstruction(string instr, string& left, string& middle, string& right);
 void readMetaFile(string filePath, vector<MetaData>& mdVector);
-void timeCalculation(Config* conf, MetaData& metaData, int& sysStatus, int& appStatus);
+void timeCalculation(const Config* conf, MetaData& metaData, int& sysStatus, int& appStatus);
 void lTrim(string& str);
 void rTrim(string& str);
 void Trim(string& str);
 string allocateMemory(int);
-void* timer(void *);
 double threadProcessing(int);
 void processRunner(int, MetaData&, sem_t&, pthread_mutex_t&);
-void initSem(Config);
-void directOutput(Config, string);
-void outputToStream(ostream&, string);
+void initSem(const Config&);
+void directOutput(const Config&, const string&);
+void outputToStream(ostream&, const string&);
 //
 // Process Control Block Struct
 struct PCB{
@@ -77,8 +77,6 @@ pthread_mutex_t keyboardLock;
 static int harddriveCount = 0;
 static int printerCount = 0;
 static int memoryBlocks = 0;
-//  flag to check if everything has been logged to the file
-static bool alreadyLogged = false;
 //
 // PCB object
 PCB ps;
@@ -97,7 +95,7 @@ int main(int argc, char* argv[]) {
     ps.processState = EXIT;
     // reads config file as first argc argument
     string configFile = argv[1];
-    Config conf;
+    shared_ptr<const Config> conf;
     vector<MetaData> mdVector;
     int sysStatus = 0; //check if S{begin} and S{finish} has been read
     int appStatus = 0; //check if A{begin} and A{finish} has been read
@@ -118,7 +116,7 @@ int main(int argc, char* argv[]) {
     ofstream fout;
 
     // read in config file propagate correctly to variables
-    conf.readConfigFile(configFile);
+    conf = Config::load(configFile);
 
     // checks whether config file is empty
     fin.clear();
@@ -131,7 +129,7 @@ int main(int argc, char* argv[]) {
 
     //checks whether meta data file is empty or if a .mdf file is not entered in config file
     fin.clear();
-    fin.open(conf.getFilePath());
+    fin.open(conf->getFilePath());
     if(fin.peek() == ifstream::traits_type::eof()){
         cerr << "Error! Empty Meta Data File or .mdf file not entered in config file" << endl;
         exit(0);
@@ -140,47 +138,19 @@ int main(int argc, char* argv[]) {
     fin.close();
 
     // reads in metadata file into metadata vector
-    readMetaFile(conf.getFilePath(), mdVector);
+    readMetaFile(conf->getFilePath(), mdVector);
 
-    initSem(conf);
+    initSem(*conf);
     // goes through the vector and calculates the process times
     for(auto& pnt : mdVector){
-        timeCalculation(&conf, pnt, sysStatus, appStatus);
+        timeCalculation(conf.get(), pnt, sysStatus, appStatus);
     }
     return 0;
 }
-/**
- * @name timer
- *
- * @details timer thread for each process. Calculates duration for each process.
- *
- * @param process
- *        process to calculate time for
- *
- */
-void* timer(void *process){
-    // creating start and end points
-    chrono::system_clock::time_point start;
-    chrono::system_clock::time_point end;
-    // Setting a time limit
-    double timeLimit = 0.1;
-    // time spent variable
-    chrono::duration<double> timeSpent;
-    //starting the timer
-    start = chrono::system_clock::now();
-    // while the time limit is not reached, calculate time
-    while(timeSpent.count() < timeLimit){
-        end = chrono::system_clock::now();
-        timeSpent = end - start;
-    }
-    // delete thread
-    pthread_exit(NULL);
-    return NULL;
-}
 /**
  * @name threadProcessing
  *
- * @description creates threads for timer
+ * @description waits for an operation to finish
  *
  * @param timeLimit
  *        The max length a process is allowed to take
@@ -188,18 +158,8 @@ void* timer(void *process){
  * @return
  */
 double threadProcessing(int timeLimit){
-//    int time = timeLimit;
-    // timerThread variable to track time
-    pthread_t timerThread;
-
-    //the time limit that a process can reach
-    auto timeEnd = chrono::system_clock::now() + chrono::milliseconds(timeLimit);
-
-    //until the max thread is reached, create a new timer thread and add it to the main
-    while(chrono::system_clock::now() < timeEnd){
-        pthread_create(&timerThread, NULL, timer, NULL);
-        pthread_join(timerThread, NULL);
-    }
+    // sleep on the shared timer instead of spinning for the whole operation
+    TimerService::instance().sleepFor(chrono::milliseconds(timeLimit));
     // current time of the thread
     auto currentTime = chrono::system_clock::now();
     // calculating the amount of time a process has taken
@@ -249,7 +209,7 @@ string allocateMemory(int totalMemory){
  * @param conf
  *        config class
  */
-void initSem(Config conf){
+void initSem(const Config &conf){
     //initialize all mutex objects
     pthread_mutex_init(&printerLock, NULL);
     pthread_mutex_init(&harddriveLock, NULL);
@@ -462,7 +422,7 @@ void readMetaFile(string filePath, vector<MetaData>& mdVector){
  * @param appStatus
  *        used to check if A process is running or ended
  */
-void timeCalculation(Config* conf, MetaData& metaData, int& sysStatus, int& appStatus){
+void timeCalculation(const Config* conf, MetaData& metaData, int& sysStatus, int& appStatus){
     int timeLimit;
     // counter to keep track of current process num
     static int processNum = 1;
@@ -637,7 +597,7 @@ void timeCalculation(Config* conf, MetaData& metaData, int& sysStatus, int& appS
  *        ostream object, can be either cout or the file
  * @param logOutput
  */
-void outputToStream(ostream& out, string logOutput){
+void outputToStream(ostream& out, const string &logOutput){
     out << logOutput << endl;
 }
 
@@ -650,37 +610,14 @@ void outputToStream(ostream& out, string logOutput){
  * @param logOutput
  *        what to output
  */
-void directOutput(Config conf, string logOutput){
-    ofstream log;
-
-    bool moniterF = false; //flag to check whether to output to moniter
-    bool fileF = false;    //flag to check whether to ouput to file
-
-    if(conf.getLogOption() == "Log to Both"){
-        moniterF = true;
-        fileF = true;
-    }else if( conf.getLogOption() == "Log to Monitor"){
-        moniterF = true;
-    }else if(conf.getLogOption() == "Log to File"){
-        fileF = true;
-    }else{
-        cerr << "Error! Log to option is not one of the options avalaible." << endl;
-        exit(0);
-    }
+void directOutput(const Config &conf, const string &logOutput){
     //ouput to monitor
-    if(moniterF){
+    if(conf.getLogTarget() & Config::LOG_TO_MONITOR){
         outputToStream(cout, logOutput);
     }
-    //output to file
-    if(fileF){
-        log.open(conf.getLogFilePath(), alreadyLogged ? ofstream::app : ofstream::trunc);
-        //check if it was already logged to file
-        if(!alreadyLogged){
-            alreadyLogged = true;
-        }
-
-        outputToStream(log, logOutput);
-        log.close();
+    //output to file, the file was already opened when the configuration was loaded
+    if(conf.getLogTarget() & Config::LOG_TO_FILE){
+        outputToStream(*conf.getLogStream(), logOutput);
     }
 }
 
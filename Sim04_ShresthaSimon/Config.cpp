@@ -26,6 +26,47 @@ Config::Config() {
 // Destructor Function
 Config::~Config() {
 
+}
+//
+/**
+ * @brief reads the configuration file and freezes it
+ *
+ * @details the returned configuration can not be changed, it is shared by pointer or reference
+ *          instead of being copied for every log line
+ *
+ * @param configFilePath
+ *        the configuration file input
+ *
+ * @return the loaded configuration
+ */
+shared_ptr<const Config> Config::load(string configFilePath) {
+    shared_ptr<Config> conf = make_shared<Config>();
+    conf->readConfigFile(configFilePath);
+    conf->freeze();
+    return conf;
+}
+//
+/**
+ * @brief turns the log option into a log target and opens the log file once
+ */
+void Config::freeze() {
+    if(this->logOption == "Log to Both"){
+        this->logTarget = LOG_TO_BOTH;
+    }else if(this->logOption == "Log to Monitor"){
+        this->logTarget = LOG_TO_MONITOR;
+    }else if(this->logOption == "Log to File"){
+        this->logTarget = LOG_TO_FILE;
+    }else{
+        cerr << "Error! Log to option is not one of the options avalaible." << endl;
+        exit(0);
+    }
+    if(this->logTarget & LOG_TO_FILE){
+        this->logStream = make_shared<ofstream>(this->logFilePath, ofstream::trunc);
+        if(!*this->logStream){
+            cerr << "Error! Can't open Log File " << this->logFilePath << endl;
+            exit(0);
+        }
+    }
 }
 //
 /**
@@ -103,8 +144,8 @@ void Config::readConfigFile(string configFilePath) {
         }else if(leftSide == "File Path"){
             try{
                 string ending = rightSide; //create copy
-                ending = ending.erase(0, ending.size()-4); //leave only .mdf portion
-                if(ending == ".mdf"){
+                ending = ending.erase(0, ending.size()-4); //leave only .mdf or .mdb portion
+                if(ending == ".mdf" || ending == ".mdb"){
                     filePath = rightSide; //if the ending is correct then assign
                 }else {
                     cerr << "Error! Missing .mdf" << endl;
@@ -361,6 +402,14 @@ const string &Config::getLogFilePath() const {
     return logFilePath;
 }
 //
+Config::LogTarget Config::getLogTarget() const {
+    return logTarget;
+}
+//
+ostream *Config::getLogStream() const {
+    return logStream.get();
+}
+//
 const string &Config::getSchedulingAlgorithm() const {
     return schedulingAlgorithm;
 }
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <memory>
 
 using namespace std;
 //
@@ -24,6 +25,14 @@ using namespace std;
 //
 class Config {
 public:
+    // where log lines go, decided once when the file is loaded
+    enum LogTarget {
+        LOG_TO_MONITOR = 1,
+        LOG_TO_FILE = 2,
+        LOG_TO_BOTH = 3
+    };
+    // reads a configuration file and freezes it so every part of the simulator shares one copy
+    static shared_ptr<const Config> load(string configFilePath);
     // Constructor
     Config();
     //Destructor
@@ -46,6 +55,9 @@ public:
     const string &getFilePath() const;
     const string &getLogOption() const;
     const string &getLogFilePath() const;
+    LogTarget getLogTarget() const;
+    // log file opened when the configuration was loaded, NULL when not logging to a file
+    ostream *getLogStream() const;
     const string &getSchedulingAlgorithm() const;
     // Function to Parse through configuration file
     void readConfigFile(string configFilePath);
@@ -59,6 +71,9 @@ public:
 
 
 private:
+    // decides the log target and opens the log file
+    void freeze();
+
     float versionNumber;
     int projectorCycleTime;
     int processorCycleTime;
@@ -78,6 +93,8 @@ private:
     string filePath;
     string logOption;
     string logFilePath;
+    LogTarget logTarget;
+    shared_ptr<ofstream> logStream;
     string memoryType;
     string schedulingAlgorithm;
 
@@ -18,14 +18,9 @@
 #include "Config.h"
 using namespace std;
 class Log {
-    private:
-        //function to check if already logged
-        static bool didFirstLog;
-        static bool checkFirstLog();
-
     public:
-        static void outputToStream(ostream&, string);
-        static void output(Config, string);
+        static void outputToStream(ostream&, const string&);
+        static void output(const Config&, const string&);
 
 };
 
@@ -0,0 +1,222 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file MetaBinary.cpp
+ *
+ * @brief implementation file for compiled metadata file class
+ *
+ * @details writes and maps .mdb files
+ *
+ */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <deque>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "MetaBinary.h"
+#include "MetaData.h"
+using namespace std;
+
+MetaBinary::MetaBinary() {
+    this->mappedFile = NULL;
+    this->mappedSize = 0;
+    this->header = NULL;
+    this->descriptors = NULL;
+    this->operations = NULL;
+    this->processes = NULL;
+}
+
+// unmaps the file
+MetaBinary::~MetaBinary() {
+    if(this->mappedFile != NULL){
+        munmap(this->mappedFile, this->mappedSize);
+    }
+}
+
+/**
+ * @details: checks if the path ends with .mdb
+ * @param filePath
+ * @return
+ */
+bool MetaBinary::isBinaryPath(const string &filePath) {
+    return filePath.size() > 4 && filePath.compare(filePath.size() - 4, 4, ".mdb") == 0;
+}
+
+/**
+ * @details: writes the operations into a .mdb file. Descriptors are stored once in the
+ *           descriptor table and the processes are indexed the same way createProcesses
+ *           splits them
+ * @param operations
+ *        every operation read from the .mdf file
+ * @param outputPath
+ *        .mdb file to write
+ */
+void MetaBinary::compile(const deque<MetaData> &operations, string outputPath) {
+    vector<string> descriptorTable;
+    map<string, uint16_t> descriptorIndex;
+    vector<MdbOperation> packed;
+    vector<MdbProcess> index;
+    MdbHeader header;
+
+    // pack every operation and intern its descriptor
+    for(auto current = operations.begin(); current != operations.end(); ++current){
+        auto found = descriptorIndex.find(current->getDescriptor());
+        if(found == descriptorIndex.end()){
+            if(current->getDescriptor().size() >= (unsigned int) MDB_DESCRIPTOR_SIZE || descriptorTable.size() >= 0xFFFF){
+                cerr << "Error! Descriptor " << current->getDescriptor() << " can not be compiled" << endl;
+                exit(0);
+            }
+            found = descriptorIndex.insert(make_pair(current->getDescriptor(), (uint16_t) descriptorTable.size())).first;
+            descriptorTable.push_back(current->getDescriptor());
+        }
+        MdbOperation op;
+        op.code = current->getCode();
+        op.reserved = 0;
+        op.descriptor = found->second;
+        op.cycles = current->getCycles();
+        packed.push_back(op);
+    }
+
+    // index every A{begin} ... A{finish} block, compared by table entry instead of by text
+    auto begin = descriptorIndex.find("begin");
+    auto finish = descriptorIndex.find("finish");
+    uint32_t beginIndex = begin == descriptorIndex.end() ? 0xFFFF : begin->second;
+    uint32_t finishIndex = finish == descriptorIndex.end() ? 0xFFFF : finish->second;
+    for(uint64_t i = 0; i < packed.size(); i++){
+        if(packed[i].code == 'A' && packed[i].descriptor == beginIndex){
+            MdbProcess p;
+            p.firstOperation = i + 1;
+            p.operationCount = 0;
+            p.ioCount = 0;
+            p.taskCount = 0;
+            for(uint64_t j = i + 1; j < packed.size() && packed[j].descriptor != finishIndex; j++){
+                if(packed[j].code == 'I' || packed[j].code == 'O'){
+                    p.ioCount++;
+                }
+                p.taskCount++;
+                p.operationCount++;
+            }
+            index.push_back(p);
+        }
+    }
+
+    // every offset is 32 bits
+    uint64_t fileSize = sizeof(MdbHeader) + (uint64_t) descriptorTable.size() * MDB_DESCRIPTOR_SIZE
+                        + (uint64_t) packed.size() * sizeof(MdbOperation) + (uint64_t) index.size() * sizeof(MdbProcess);
+    if(fileSize > UINT32_MAX){
+        cerr << "Error! Meta Data File is too large to be compiled, a .mdb file has to be under 4 GiB" << endl;
+        exit(0);
+    }
+
+    memcpy(header.magic, MDB_MAGIC, 4);
+    header.version = MDB_VERSION;
+    header.descriptorCount = descriptorTable.size();
+    header.operationCount = packed.size();
+    header.processCount = index.size();
+    header.descriptorOffset = sizeof(MdbHeader);
+    header.operationOffset = header.descriptorOffset + header.descriptorCount * MDB_DESCRIPTOR_SIZE;
+    header.processOffset = header.operationOffset + header.operationCount * sizeof(MdbOperation);
+
+    ofstream outFile(outputPath, ios::out | ios::binary | ios::trunc);
+    if(!outFile){
+        cerr << "Error! Can't write " << outputPath << endl;
+        exit(0);
+    }
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(auto &descriptor : descriptorTable){
+        char entry[MDB_DESCRIPTOR_SIZE] = {0};
+        memcpy(entry, descriptor.c_str(), descriptor.size());
+        outFile.write(entry, MDB_DESCRIPTOR_SIZE);
+    }
+    outFile.write(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(MdbOperation));
+    outFile.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(MdbProcess));
+    outFile.close();
+}
+
+/**
+ * @details: maps a .mdb file and checks that the tables fit inside of it
+ * @param filePath
+ *        .mdb file to map
+ */
+void MetaBinary::open(string filePath) {
+    struct stat fileInfo;
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+
+    if(fd < 0 || fstat(fd, &fileInfo) != 0 || fileInfo.st_size < (off_t) sizeof(MdbHeader)){
+        cerr << "Error! Compiled Meta Data File can not be read" << endl;
+        exit(0);
+    }
+    this->mappedSize = fileInfo.st_size;
+    void *mapped = mmap(NULL, this->mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapped == MAP_FAILED){
+        cerr << "Error! Compiled Meta Data File can not be read" << endl;
+        exit(0);
+    }
+    this->mappedFile = static_cast<char*>(mapped);
+    this->header = reinterpret_cast<const MdbHeader*>(this->mappedFile);
+
+    // check that this is a compiled file and that every table is inside the file
+    if(memcmp(this->header->magic, MDB_MAGIC, 4) != 0 || this->header->version != MDB_VERSION
+       || this->header->descriptorOffset + (uint64_t) this->header->descriptorCount * MDB_DESCRIPTOR_SIZE > this->mappedSize
+       || this->header->operationOffset + (uint64_t) this->header->operationCount * sizeof(MdbOperation) > this->mappedSize
+       || this->header->processOffset + (uint64_t) this->header->processCount * sizeof(MdbProcess) > this->mappedSize){
+        cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+        exit(0);
+    }
+    this->descriptors = this->mappedFile + this->header->descriptorOffset;
+    this->operations = reinterpret_cast<const MdbOperation*>(this->mappedFile + this->header->operationOffset);
+    this->processes = reinterpret_cast<const MdbProcess*>(this->mappedFile + this->header->processOffset);
+
+    // every descriptor has to end inside of its entry
+    for(uint32_t i = 0; i < this->header->descriptorCount; i++){
+        if(this->descriptors[i * MDB_DESCRIPTOR_SIZE + MDB_DESCRIPTOR_SIZE - 1] != '\0'){
+            cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+            exit(0);
+        }
+    }
+    // every operation has to point at a descriptor in the table
+    for(uint32_t i = 0; i < this->header->operationCount; i++){
+        if(this->operations[i].descriptor >= this->header->descriptorCount){
+            cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+            exit(0);
+        }
+    }
+    for(uint32_t i = 0; i < this->header->processCount; i++){
+        if((uint64_t) this->processes[i].firstOperation + this->processes[i].operationCount > this->header->operationCount){
+            cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+            exit(0);
+        }
+    }
+}
+
+uint32_t MetaBinary::getDescriptorCount() const {
+    return this->header->descriptorCount;
+}
+
+uint32_t MetaBinary::getOperationCount() const {
+    return this->header->operationCount;
+}
+
+uint32_t MetaBinary::getProcessCount() const {
+    return this->header->processCount;
+}
+
+const MdbOperation &MetaBinary::getOperation(uint32_t i) const {
+    return this->operations[i];
+}
+
+const MdbProcess &MetaBinary::getProcess(uint32_t i) const {
+    return this->processes[i];
+}
+
+const char *MetaBinary::getDescriptor(uint16_t i) const {
+    return this->descriptors + i * MDB_DESCRIPTOR_SIZE;
+}
@@ -0,0 +1,89 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file MetaBinary.h
+ *
+ * @brief header for compiled metadata file class
+ *
+ * @details a .mdb file is a metadata file that has already been parsed. It holds a table of
+ *          descriptors, the operations packed into 8 bytes each and an index of the processes
+ *          with their IO and task counts. The file is mapped straight into memory so nothing
+ *          has to be parsed when the simulator starts. Offsets are 32 bits so a compiled file
+ *          has to be under 4 GiB. Sim05 keeps the same format with a timing table added
+ *          ( version 2 ), a change to the layout has to be made to both
+ *
+ */
+#ifndef CS446PROJ4_METABINARY_H
+#define CS446PROJ4_METABINARY_H
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <stdint.h>
+
+#include "MetaData.h"
+using namespace std;
+
+// first bytes of every compiled file
+const char MDB_MAGIC[4] = {'M', 'D', 'B', '1'};
+const uint32_t MDB_VERSION = 1;
+// room for each descriptor in the descriptor table, including the ending null
+const int MDB_DESCRIPTOR_SIZE = 32;
+
+// start of the file, offsets are from the beginning of the file
+struct MdbHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t descriptorCount;
+    uint32_t operationCount;
+    uint32_t processCount;
+    uint32_t descriptorOffset;
+    uint32_t operationOffset;
+    uint32_t processOffset;
+};
+
+// one operation, the descriptor is an index into the descriptor table
+struct MdbOperation {
+    uint8_t code;
+    uint8_t reserved;
+    uint16_t descriptor;
+    int32_t cycles;
+};
+
+// one A{begin} ... A{finish} block, firstOperation is the operation after A{begin}
+struct MdbProcess {
+    uint32_t firstOperation;
+    uint32_t operationCount;
+    uint32_t ioCount;
+    uint32_t taskCount;
+};
+
+class MetaBinary {
+    public:
+        MetaBinary();
+        ~MetaBinary();
+        // checks if a file path is a compiled metadata file
+        static bool isBinaryPath(const string&);
+        // writes operations read from a .mdf file into a .mdb file
+        static void compile(const deque<MetaData>&, string);
+        // maps a .mdb file into memory
+        void open(string);
+
+        uint32_t getDescriptorCount() const;
+        uint32_t getOperationCount() const;
+        uint32_t getProcessCount() const;
+        const MdbOperation &getOperation(uint32_t) const;
+        const MdbProcess &getProcess(uint32_t) const;
+        const char *getDescriptor(uint16_t) const;
+
+    private:
+        char *mappedFile;
+        size_t mappedSize;
+        const MdbHeader *header;
+        const char *descriptors;
+        const MdbOperation *operations;
+        const MdbProcess *processes;
+};
+
+
+#endif //CS446PROJ4_METABINARY_H
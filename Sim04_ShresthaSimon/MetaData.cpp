@@ -11,6 +11,7 @@
 // Header Files
 //
 #include "MetaData.h"
+#include "Tokenizer.h"
 #include <iostream>
 #include <string>
 #include <fstream>
@@ -129,23 +130,17 @@ void MetaData::Trim(string& str){
  *        vector used to store the words created from parsing each line
  */
 bool MetaData::returnInstructions(string line, deque<string>& mdVector){
-    string temp;
-    for(unsigned int i = 0; i < line.size(); i++){ //iterate through entire line
-        if(line[i] == ';'){ //when a semicolon is found
-            mdVector.push_back(temp); // push everything in temp so far into vector
-            line.erase(0, i); //erase everything read so far in the line
-            i = 0; //restart iteration
-            temp.erase(); //erase temp to get new word
-            continue;
-        }else if(line[i] == '.'){ //same thing as semicolon but for a period as the last word ends with period
-            mdVector.push_back(temp);
-            line.erase(0, i);
-            i = 0;
+    const char *wordStart = line.data(); //start of the word being read
+    const char *lineEnd = line.data() + line.size();
+    Tokenizer tokenizer(wordStart, lineEnd);
+    for(const char *pos = tokenizer.next(); pos != lineEnd; pos = tokenizer.next()){ //jump between delimiters
+        if(*pos == ';'){ //when a semicolon is found
+            mdVector.push_back(string(wordStart, pos)); // push everything since the last word into vector
+            wordStart = pos + 1; //next word starts after the semicolon
+        }else if(*pos == '.'){ //same thing as semicolon but for a period as the last word ends with period
+            mdVector.push_back(string(wordStart, pos));
             return true; //return true say that we have reached the period
-        }else{
-            temp.append(string(1,line[i])); //add every iteration to temp
         }
-
     }
     return false; // return false if period was not found
 
@@ -172,39 +167,36 @@ bool MetaData::returnInstructions(string line, deque<string>& mdVector){
  *        right of the curly braces = cycles
  */
 bool MetaData::parseInstruction(string instr, string& left, string& middle, string& right){
+    const char *begin = instr.data();
+    const char *end = instr.data() + instr.size();
+    const char *braces[2]; // position of the two curly braces
     int state = 0; // counter used to append to different sides and to check curly braces
     bool seenLeft = false; // flag for left curly brace
     bool seenRight = false; // flag for right curly brace
-    for(unsigned int i = 0; i < instr.size(); i++){
-        if(instr[i] == '{'){
-            if(!seenLeft){ //if the left curly brace has not been seen then add one to state and mark true
-                state += 1;
-                seenLeft = true;
-            }else{
+    Tokenizer tokenizer(begin, end);
+    for(const char *pos = tokenizer.next(); pos != end; pos = tokenizer.next()){
+        if(*pos == '{'){
+            if(seenLeft){ //a second left curly brace
                 return false;
             }
-        }else if(instr[i] == '}'){
-            if(!seenRight){ //if the right has not been seen then add one to state and mark true
-                state += 1;
-                seenRight = true;
-            }else{
+            seenLeft = true;
+        }else if(*pos == '}'){
+            if(seenRight){ //a second right curly brace
                 return false;
             }
+            seenRight = true;
         }else{
-            if(state == 0){
-                left.append(string(1,instr[i])); //append to left until left curly brace this includes white spaces
-            }else if(state == 1){
-                middle.append(string(1,instr[i])); //append until right curly brace this includes white spaces
-            }else if(state == 2){
-                right.append(string(1,instr[i])); // append everything after curly brace this includes white spaces
-            }else{
-                return false;
-            }
+            continue;
         }
+        braces[state] = pos;
+        state += 1;
     }
     if(state != 2){
         return false; //if duplicate curly braces are found
     }
+    left.append(begin, braces[0]); //everything before the first curly brace this includes white spaces
+    middle.append(braces[0] + 1, braces[1]); //everything between the curly braces this includes white spaces
+    right.append(braces[1] + 1, end); // everything after the second curly brace this includes white spaces
     return true;
 }
 /**
@@ -225,11 +217,6 @@ void MetaData::readMetaFile(string filePath, deque<MetaData>& mdVector){
     // tokenizer to parse through entire metadata file
     deque<string> parser;
     string pos; //reads in code, descriptor, and cycle as one string
-    string temp;
-    string code;
-    string descriptor;
-    string cycles;
-    string emptyCycle = ""; //used to check for missing cycle number
     bool seenDotFlag = false; //flag used to indicate end of the file
 
 
@@ -263,40 +250,54 @@ void MetaData::readMetaFile(string filePath, deque<MetaData>& mdVector){
 
     // Parser for entire vector that contains all words
     for(auto pnt = parser.begin(); pnt != parser.end(); pnt++){
+        //convert the data read into vector that uses metadata datatype
+        mdVector.push_back(MetaData::buildOperation(*pnt));
+    }
 
-        pos = *pnt; //begin assignment of variables
-        code.erase(); //reset code to assign code of next word
-        descriptor.erase(); //same thing as code
-        cycles.erase(); //same thing as code
-
-        //parse all words and assign, otherwise output error
-        if(!MetaData::parseInstruction(pos, code, descriptor, cycles)){
-            cerr << "Meta Data file is formatted incorrectly" << endl;
-            exit(0);
-        }
+}
+/**
+ * @name buildOperation
+ *
+ * @brief turns one word of the metadata file into an operation
+ *
+ * @details splits the word around the curly braces, trims it and checks that
+ *          nothing is missing and that the cycle number is not negative
+ *
+ * @param instr
+ *        word read from the metadata file, without the ; or .
+ *
+ * @return
+ *        operation built from the word
+ */
+MetaData MetaData::buildOperation(string instr){
+    string code;
+    string descriptor;
+    string cycles;
 
-        MetaData::Trim(code); //trim any whitespaces that may appear
-        MetaData::Trim(descriptor);
-        MetaData::Trim(cycles);
+    //parse the word and assign, otherwise output error
+    if(!MetaData::parseInstruction(instr, code, descriptor, cycles)){
+        cerr << "Meta Data file is formatted incorrectly" << endl;
+        exit(0);
+    }
 
+    MetaData::Trim(code); //trim any whitespaces that may appear
+    MetaData::Trim(descriptor);
+    MetaData::Trim(cycles);
 
-        // if any of the variables are empty then output error
-        if(code == "" || descriptor == "" || cycles == ""){
-            cerr << "Missing code, descriptor, or cycles!" << endl;
-            exit(0);
-        }
 
-        //if cycles is negative
-        if(stoi(cycles) < 0){
-            cerr << "Cycle number is negative." << endl;
-            exit(0);
-        }
-        //convert the data read into vector that uses metadata datatype
-        MetaData input(code[0], descriptor, stoi(cycles));
-        mdVector.push_back(input);
+    // if any of the variables are empty then output error
+    if(code == "" || descriptor == "" || cycles == ""){
+        cerr << "Missing code, descriptor, or cycles!" << endl;
+        exit(0);
+    }
 
+    //if cycles is negative
+    if(stoi(cycles) < 0){
+        cerr << "Cycle number is negative." << endl;
+        exit(0);
     }
 
+    return MetaData(code[0], descriptor, stoi(cycles));
 }
 
 
@@ -36,6 +36,7 @@ public:
     static void readMetaFile(string, deque<MetaData>&);
     static bool returnInstructions(string, deque<string>& );
     static bool parseInstruction(string , string& , string& , string& );
+    static MetaData buildOperation(string);
     static void lTrim(string& str);
     static void rTrim(string& str);
     static void Trim(string& str);
@@ -20,31 +20,68 @@
 #include "Config.h"
 #include "MetaData.h"
 #include "Process.h"
+#include "MetaBinary.h"
 #include "Log.h"
+#include "VirtualClock.h"
+#include "TimerService.h"
 #include "OperatingSystem.h"
 
+const OperatingSystem::OperationEntry OperatingSystem::operationTable[] = {
+    {'P', "run", &Config::getProcessorCycleTime, NULL, &OperatingSystem::processorLock, NULL, &SimDevices::processor, "processing action", false},
+    {'I', "hard drive", &Config::getHarddriveCycleTime, &OperatingSystem::harddriveSemaphore, &OperatingSystem::harddriveLock, &OperatingSystem::harddriveCount, &SimDevices::harddrive, "hard drive input", false},
+    {'I', "keyboard", &Config::getKeyboardCycleTime, &OperatingSystem::keyboardSempahore, &OperatingSystem::keyboardLock, NULL, &SimDevices::keyboard, "keyboard input", false},
+    {'I', "mouse", &Config::getMouseCycleTime, &OperatingSystem::mouseSemaphore, &OperatingSystem::mouseLock, NULL, &SimDevices::mouse, "mouse input", false},
+    {'O', "hard drive", &Config::getHarddriveCycleTime, &OperatingSystem::harddriveSemaphore, &OperatingSystem::harddriveLock, &OperatingSystem::harddriveCount, &SimDevices::harddrive, "hard drive output", false},
+    {'O', "monitor", &Config::getMoniterDisplayTime, &OperatingSystem::monitorSemaphore, &OperatingSystem::monitorLock, NULL, &SimDevices::monitor, "monitor input", false},
+    {'O', "printer", &Config::getPrinterCycleTime, &OperatingSystem::printerSemaphore, &OperatingSystem::printerLock, &OperatingSystem::printerCount, &SimDevices::printer, "printer output", false},
+    {'M', "block", &Config::getMemoryCycleTime, NULL, NULL, NULL, NULL, "memory blocking", false},
+    {'M', "allocate", &Config::getMemoryCycleTime, NULL, NULL, NULL, NULL, NULL, true}
+};
+
 // parameterized constructor the initializes everything
-OperatingSystem::OperatingSystem(Config *conf, string config) {
-    //reading in configuration file
-    conf->readConfigFile(config);
-    // create queue for tasks
-    deque<MetaData> systemOperations;
-    //read in metadata file
-    MetaData::readMetaFile(conf->getFilePath(), systemOperations);
-    // create processes from metadata file
-    Process::createProcesses(this->processes, systemOperations);
+OperatingSystem::OperatingSystem(shared_ptr<const Config> conf, RunOptions options) {
+    // keep the configuration alive for as long as the system runs
+    this->config = conf;
+    this->stream = NULL;
+    // simulated time starts at 0, otherwise START_TIME is used
+    this->clock = options.virtualClock ? new VirtualClock() : NULL;
+    this->devices = NULL;
+    if(MetaBinary::isBinaryPath(conf->getFilePath()) && options.streaming){
+        cerr << "Error! --stream can not be used with a compiled Meta Data File, it is already split into processes" << endl;
+        exit(0);
+    }
+    if(MetaBinary::isBinaryPath(conf->getFilePath())){
+        // compiled files are already split into processes so there is nothing to parse
+        MetaBinary metaBinary;
+        metaBinary.open(conf->getFilePath());
+        Process::createProcesses(this->processes, metaBinary);
+    }else if(options.streaming){
+        // processes are read on their own thread and handed over as they are parsed
+        this->stream = new ProcessStream(conf->getFilePath());
+        this->stream->start();
+    }else{
+        // create queue for tasks
+        deque<MetaData> systemOperations;
+        //read in metadata file
+        MetaData::readMetaFile(conf->getFilePath(), systemOperations);
+        // create processes from metadata file
+        Process::createProcesses(this->processes, systemOperations);
+    }
     //initalizes all mutexes
     pthread_mutex_init(&this->printerLock, NULL);
     pthread_mutex_init(&this->harddriveLock, NULL);
     pthread_mutex_init(&this->monitorLock, NULL);
     pthread_mutex_init(&this->mouseLock, NULL);
     pthread_mutex_init(&this->keyboardLock, NULL);
+    pthread_mutex_init(&this->processorLock, NULL);
+    pthread_mutex_init(&this->memoryLock, NULL);
+    pthread_mutex_init(&this->logLock, NULL);
     // initialize all semaphores
     sem_init(&this->harddriveSemaphore, 0, conf->getHarddriveResources());
     sem_init(&this->printerSemaphore, 0, conf->getPrinterResources());
     sem_init(&this->monitorSemaphore, 0, 1);
     sem_init(&this->keyboardSempahore, 0, 1);
-    sem_init(&this->monitorSemaphore, 0, 1);
+    sem_init(&this->mouseSemaphore, 0, 1);
     // create start time
     this->START_TIME = chrono::system_clock::now();
     // set counters to 0
@@ -53,38 +90,16 @@ OperatingSystem::OperatingSystem(Config *conf, string config) {
     this->memoryBlocks = 0;
 
 }
-/**
- * @name timer
- *
- * @details timer thread for each process. Calculates duration for each process.
- *
- * @param process
- *        process to calculate time for
- *
- */
-void* OperatingSystem::timer(void *emp) {
-    // creating start and end points
-    chrono::system_clock::time_point start;
-    chrono::system_clock::time_point end;
-    // Setting a time limit
-    double timeLimit = 0.1;
-    // time spent variable
-    chrono::duration<double> timeSpent;
-    //starting the timer
-    start = chrono::system_clock::now();
-    // while the time limit is not reached, calculate time
-    while(timeSpent.count() < timeLimit){
-        end = chrono::system_clock::now();
-        timeSpent = end - start;
-    }
-    // delete thread
-    pthread_exit(NULL);
-    return NULL;
+// destructor that stops the metadata reader
+OperatingSystem::~OperatingSystem() {
+    delete this->stream;
+    delete this->clock;
+    delete this->devices;
 }
 /**
  * @name processthread
  *
- * @description creates threads for timer
+ * @description waits for an operation to finish
  *
  * @param timeLimit
  *        The max length a process is allowed to take
@@ -92,22 +107,29 @@ void* OperatingSystem::timer(void *emp) {
  * @return
  */
 double OperatingSystem::processThread(int timeLimit) {
-//    int time = timeLimit;
-    // timerThread variable to track time
-    pthread_t timerThread;
-
-    //the time limit that a process can reach
-    auto timeEnd = chrono::system_clock::now() + chrono::milliseconds(timeLimit);
-
-    //until the max thread is reached, create a new timer thread and add it to the main
-    while(chrono::system_clock::now() < timeEnd){
-        pthread_create(&timerThread, NULL, this->timer, NULL);
-        pthread_join(timerThread, NULL);
+    // simulated time jumps straight to the end of the operation
+    if(this->clock != NULL){
+        this->clock->advance(timeLimit);
+        return this->clock->now();
     }
-    // current time of the thread
-    auto currentTime = chrono::system_clock::now();
+    // sleep on the shared timer instead of spinning for the whole operation
+    TimerService::instance().sleepFor(chrono::milliseconds(timeLimit));
     // calculating the amount of time a process has taken
-    return chrono::duration<double>(currentTime - this->START_TIME).count();
+    return this->elapsed();
+}
+/**
+ * @name elapsed
+ *
+ * @description time since the simulator started, simulated time when running on the virtual clock
+ *
+ * @return
+ *        seconds since the start
+ */
+double OperatingSystem::elapsed() {
+    if(this->clock != NULL){
+        return this->clock->now();
+    }
+    return chrono::duration<double>(chrono::system_clock::now() - this->START_TIME).count();
 }
 /**
  * @name threadOperation
@@ -164,6 +186,222 @@ deque<Process> OperatingSystem::getProcesses() {
     return this->processes;
 }
 
+/**
+ * @description: moves streamed processes onto the ready queue. Waits for one process if the
+ *               ready queue is empty, then takes whatever else has been parsed so far
+ * @param ready
+ *        ready queue of processes
+ * @return
+ *        false if the ready queue is empty and the file is done
+ */
+bool OperatingSystem::admitProcesses(ReadyQueue &ready) {
+    Process p;
+    if(this->stream == NULL){
+        return !ready.empty();
+    }
+    if(ready.empty()){
+        if(!this->stream->next(p)){
+            return false;
+        }
+        ready.push(p);
+    }
+    while(this->stream->tryNext(p)){
+        ready.push(p);
+    }
+    return true;
+}
+
+/**
+ * @description: starts every process in the queue on its own thread. They are started in the
+ *               order the scheduler left them in and then compete for the processor and devices.
+ *               On the simulated clock each process becomes a task instead of a thread and the
+ *               scheduler order decides who gets the processor next
+ * @param ready
+ *        ready queue of processes, empty afterwards
+ * @param conf
+ */
+void OperatingSystem::startProcesses(ReadyQueue &ready, const Config *conf) {
+    if(this->clock != NULL){
+        if(this->devices == NULL){
+            this->devices = new SimDevices(conf);
+        }
+        while(!ready.empty()){
+            ProcessTask task;
+            task.process = ready.pop();
+            task.operations = task.process.getOperations();
+            task.next = 0;
+            task.rank = this->tasks.size();
+            task.held = NULL;
+            this->tasks.push_back(task);
+            ProcessTask *started = &this->tasks.back();
+            this->clock->schedule(0, [this, started, conf]() { this->resumeTask(started, conf); });
+        }
+        return;
+    }
+    while(!ready.empty()){
+        ProcessThread started;
+        started.os = this;
+        started.process = ready.pop();
+        started.conf = conf;
+        this->running.push_back(started);
+        pthread_create(&this->running.back().thread, NULL, processRunner, &this->running.back());
+    }
+}
+
+/**
+ * @description: waits for every process started by startProcesses
+ */
+void OperatingSystem::waitForProcesses() {
+    if(this->clock != NULL){
+        this->clock->run();
+        this->tasks.clear();
+        return;
+    }
+    for(auto &started : this->running){
+        pthread_join(started.thread, NULL);
+    }
+    this->running.clear();
+}
+
+// runs one process start to finish
+void *OperatingSystem::processRunner(void *parameter) {
+    ProcessThread *started = static_cast<ProcessThread*>(parameter);
+    started->os->process(started->process, started->conf);
+    return NULL;
+}
+
+/**
+ * @description: starts the next operation of a task. If the resource it needs is in use the task
+ *               waits in line and is resumed when the resource is handed to it, otherwise the end
+ *               of the operation is scheduled and resumes the task again
+ * @param task
+ *        task to run
+ * @param conf
+ */
+void OperatingSystem::resumeTask(ProcessTask *task, const Config *conf) {
+    Process &p = task->process;
+    if(task->next == 0 && task->held == NULL){
+        this->processSystem("OS: Preparing process " + to_string(p.getProcessCount()), conf);
+        this->processSystem("OS: Starting process " + to_string(p.getProcessCount()), conf);
+        p.setProcessState(Process::ProcessState::READY);
+    }
+    // skip anything that is not run, like the S and A codes
+    int timeLimit = 0;
+    string start;
+    string end;
+    SimResource *resource = NULL;
+    while(task->next < task->operations.size()){
+        resource = this->taskOperation(task->operations[task->next], conf, timeLimit, start, end);
+        if(!start.empty()){
+            break;
+        }
+        task->next++;
+    }
+    if(task->next == task->operations.size()){
+        this->processSystem("OS: removing process " + to_string(p.getProcessCount()), conf);
+        p.setProcessState(Process::ProcessState::EXIT);
+        return;
+    }
+    // wait in line unless the resource was already handed over
+    if(resource != NULL && task->held != resource){
+        p.setProcessState(Process::ProcessState::WAIT);
+        if(!resource->acquire(task, resource == &this->devices->processor ? task->rank : 0)){
+            return;
+        }
+        task->held = resource;
+    }
+    p.setProcessState(Process::ProcessState::RUNNING);
+    this->processSystem("Process " + to_string(p.getProcessCount()) + ": " + start, conf);
+    this->clock->schedule(timeLimit, [this, task, conf, end]() {
+        this->processSystem("Process " + to_string(task->process.getProcessCount()) + ": " + end, conf);
+        task->process.setProcessState(Process::ProcessState::READY);
+        // pass the resource on before moving to the next operation
+        if(task->held != NULL){
+            ProcessTask *woken = task->held->release();
+            if(woken != NULL){
+                woken->held = task->held;
+                this->clock->schedule(0, [this, woken, conf]() { this->resumeTask(woken, conf); });
+            }
+            task->held = NULL;
+        }
+        task->next++;
+        this->resumeTask(task, conf);
+    });
+}
+
+/**
+ * @description: works out what an operation needs from the operation table, the same entry
+ *               process() runs it by
+ * @param metaData
+ *        operation to run
+ * @param conf
+ * @param timeLimit
+ *        set to how long the operation takes
+ * @param start
+ *        set to what to print when it starts, empty if the operation is not run
+ * @param end
+ *        set to what to print when it ends
+ * @return
+ *        resource the operation needs, NULL if none
+ */
+SimResource *OperatingSystem::taskOperation(const MetaData &metaData, const Config *conf, int &timeLimit, string &start, string &end) {
+    const OperationEntry *entry = findOperation(metaData);
+    start.clear();
+    if(entry == NULL){
+        return NULL;
+    }
+    timeLimit = metaData.getCycles() + (conf->*entry->cycleTime)();
+    if(entry->allocates){
+        // the block is taken when the operation starts, like in process()
+        start = "allocating memory";
+        end = "memory allocated at 0x" + this->generateMemoryLocation(this->allocateMemory(conf));
+        return NULL;
+    }
+    start = string("start ") + entry->print;
+    end = string("end ") + entry->print;
+    return entry->resource == NULL ? NULL : &(this->devices->*entry->resource);
+}
+
+/**
+ * @description: looks an operation up in the operation table
+ * @param metaData
+ * @return
+ *        the entry, NULL if the operation is not run
+ */
+const OperatingSystem::OperationEntry *OperatingSystem::findOperation(const MetaData &metaData) {
+    for(const OperationEntry &entry : operationTable){
+        if(entry.code == metaData.getCode() && metaData.getDescriptor() == entry.descriptor){
+            return &entry;
+        }
+    }
+    // only P is let through with another descriptor
+    if(metaData.getCode() == 'I' || metaData.getCode() == 'O' || metaData.getCode() == 'M'){
+        cerr << "Wrong descriptor for " << metaData.getCode() << endl;
+        exit(0);
+    }
+    return NULL;
+}
+
+/**
+ * @description: takes the next memory block, going back to the first once memory runs out
+ * @param conf
+ * @return
+ *        address of the block
+ */
+int OperatingSystem::allocateMemory(const Config *conf) {
+    pthread_mutex_lock(&this->memoryLock);
+    this->memoryBlocks = (this->memoryBlocks > ((float) conf->getMemory()/(float) conf->getMemBlockSize())) ? 0 : this->memoryBlocks;
+    auto memory = this->memoryBlocks * conf->getMemBlockSize();
+    // if there is not enough memory.
+    this->memoryBlocks++;
+    int totalBlocks = conf->getMemory()/conf->getMemBlockSize();
+    if(this->memoryBlocks > totalBlocks){
+        this->memoryBlocks = 0;
+    }
+    pthread_mutex_unlock(&this->memoryLock);
+    return memory;
+}
+
 /**
  * @description: resets memory blocks used to 0
  */
@@ -177,13 +415,25 @@ void OperatingSystem::resetMemory() {
  *        what to print
  * @param conf
  */
-void OperatingSystem::processSystem(string print, Config * conf) {
-    //get the current time
-    auto currentTime = chrono::system_clock::now();
-    // get total time
-    auto timed = (chrono::duration<double>(currentTime-this->START_TIME).count());
+void OperatingSystem::processSystem(string print, const Config *conf) {
     //print statement
+    this->logEvent(conf, print);
+}
+/**
+ * @description: takes the time and prints the line while holding the log lock, so a thread can
+ *               not stamp a line and then print it after a line with a later time
+ * @param conf
+ * @param print
+ *        what to print after the time
+ * @return
+ *        time printed on the line
+ */
+double OperatingSystem::logEvent(const Config *conf, const string &print) {
+    pthread_mutex_lock(&this->logLock);
+    auto timed = this->elapsed();
     Log::output(*conf, to_string(timed) + " - " + print);
+    pthread_mutex_unlock(&this->logLock);
+    return timed;
 }
 /**
  * @details: handles printing and thread operation of I/O processes
@@ -204,27 +454,23 @@ void OperatingSystem::processSystem(string print, Config * conf) {
  * @param print
  *        what to print
  */
-void OperatingSystem::processIOOperation(MetaData metaData, Config *conf, sem_t &semaphore,
+void OperatingSystem::processIOOperation(MetaData metaData, const Config *conf, sem_t &semaphore,
                                          pthread_mutex_t &lock, int &count , int processNumber,
                                          int cycleTime, string print) {
     // set timelimit
     int timeLimit = metaData.getCycles() + cycleTime;
-    //get current time
-    auto currentTime = chrono::system_clock::now();
-    //set the time
-    metaData.setStartTime(chrono::duration<double>(currentTime-this->START_TIME).count());
     // what to do if the resource is printer / harddrive or not
     if(count >= 0){
         //output start
-        Log::output(*conf, to_string(metaData.getStartTime()) + " - " + "Process " + to_string(processNumber) + ": start " + print);
+        metaData.setStartTime(this->logEvent(conf, "Process " + to_string(processNumber) + ": start " + print));
         //process thread
         this->threadOperation(timeLimit, metaData, semaphore, lock);
         //output end
-        Log::output(*conf, to_string(metaData.getTime()) + " - " + "Process " + to_string(processNumber) + ": end " + print);
+        metaData.setTime(this->logEvent(conf, "Process " + to_string(processNumber) + ": end " + print));
     }else{
-        Log::output(*conf, to_string(metaData.getStartTime()) + " - " + "Process " + to_string(processNumber) + ": start " + print);
+        metaData.setStartTime(this->logEvent(conf, "Process " + to_string(processNumber) + ": start " + print));
         this->threadOperation(timeLimit, metaData, semaphore, lock);
-        Log::output(*conf, to_string(metaData.getTime()) + " - " + "Process " + to_string(processNumber) + ": end " + print);
+        metaData.setTime(this->logEvent(conf, "Process " + to_string(processNumber) + ": end " + print));
     }
 }
 /**
@@ -235,19 +481,15 @@ void OperatingSystem::processIOOperation(MetaData metaData, Config *conf, sem_t
  * @param processNumber
  * @param cycleTime
  */
-void OperatingSystem::processAction(string print, Config *conf, MetaData metaData, int processNumber, int cycleTime) {
+void OperatingSystem::processAction(string print, const Config *conf, MetaData metaData, int processNumber, int cycleTime) {
     //set time limit
     auto timeLimit = metaData.getCycles() + cycleTime;
-    //get current time
-    auto currentTime = chrono::system_clock::now();
-    // set start time
-    metaData.setStartTime(chrono::duration<double>(currentTime-this->START_TIME).count());
     //output start
-    Log::output(*conf, to_string(metaData.getStartTime()) + " - " + "Process " + to_string(processNumber) + ": start " + print);
-    //set processing time
-    metaData.setTime(this->processThread(timeLimit));
+    metaData.setStartTime(this->logEvent(conf, "Process " + to_string(processNumber) + ": start " + print));
+    //wait for the operation
+    this->processThread(timeLimit);
     // output end
-    Log::output(*conf, to_string(metaData.getTime()) + " - " + "Process " + to_string(processNumber) + ": end " + print);
+    metaData.setTime(this->logEvent(conf, "Process " + to_string(processNumber) + ": end " + print));
 }
 
 /**
@@ -255,7 +497,7 @@ void OperatingSystem::processAction(string print, Config *conf, MetaData metaDat
  * @param p
  * @param conf
  */
-void OperatingSystem::process(Process &p, Config *conf) {
+void OperatingSystem::process(Process &p, const Config *conf) {
     //get the tasks
     auto processOperations = p.getOperations();
     // for I/O that don't have resource count
@@ -267,77 +509,32 @@ void OperatingSystem::process(Process &p, Config *conf) {
     p.setProcessState(Process::ProcessState::READY);
     // go through queue
     for(auto metaData : processOperations){
-        // if code is p
-        if(metaData.getCode() == 'P' && metaData.getDescriptor() == "run"){
-            // process
-            this->processAction("processing action", conf, metaData, p.getProcessCount(), conf->getProcessorCycleTime());
-        // if code is I
-        }else if(metaData.getCode() == 'I'){
-            if(metaData.getDescriptor() == "hard drive") {
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processIOOperation(metaData, conf, this->harddriveSemaphore, this->harddriveLock, this->harddriveCount, p.getProcessCount(), conf->getHarddriveCycleTime(), "hard drive input");
-                p.setProcessState(Process::ProcessState::READY);
-            }else if(metaData.getDescriptor() == "keyboard") {
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processIOOperation(metaData, conf, this->keyboardSempahore, this->keyboardLock, noResources, p.getProcessCount(), conf->getKeyboardCycleTime(), "keyboard input");
-                p.setProcessState(Process::ProcessState::READY);
-            }else if(metaData.getDescriptor() == "mouse"){
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processIOOperation(metaData, conf, this->mouseSemaphore, this->mouseLock, noResources, p.getProcessCount(), conf->getMouseCycleTime(), "mouse input");
-                p.setProcessState(Process::ProcessState::RUNNING);
-            }else{
-                cerr << "Wrong descriptor for I" << endl;
-                exit(0);
-            }
-            //if code is O
-        }else if(metaData.getCode() == 'O'){
-            if(metaData.getDescriptor() == "hard drive"){
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processIOOperation(metaData, conf, this->harddriveSemaphore, this->harddriveLock, this->harddriveCount, p.getProcessCount(), conf->getHarddriveCycleTime(), "hard drive output");
-                p.setProcessState(Process::ProcessState::READY);
-            }else if(metaData.getDescriptor() == "monitor"){
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processIOOperation(metaData, conf, this->monitorSemaphore, this->monitorLock, noResources, p.getProcessCount(), conf->getMoniterDisplayTime(), "monitor input");
-                p.setProcessState(Process::ProcessState::READY);
-            }else if(metaData.getDescriptor() == "printer"){
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processIOOperation(metaData, conf, this->printerSemaphore, this->printerLock, this->printerCount, p.getProcessCount(), conf->getPrinterCycleTime(), "printer output");
-                p.setProcessState(Process::ProcessState::READY);
-            }else{
-                cerr << "Wrong descriptor for O" << endl;
-                exit(0);
-            }
-            //if code is M
-        }else if(metaData.getCode() == 'M'){
-            if(metaData.getDescriptor() == "block"){
-                p.setProcessState(Process::ProcessState::RUNNING);
-                this->processAction("memory blocking", conf, metaData, p.getProcessCount(), conf->getMemoryCycleTime());
-                p.setProcessState(Process::ProcessState::READY);
-            }else if(metaData.getDescriptor() == "allocate"){
-                // for allocate, do the same thing as processIOOperation function but add memoryblocks
-                p.setProcessState(Process::ProcessState::RUNNING);
-                auto timeLimit = metaData.getCycles() + conf->getMemoryCycleTime();
-                auto currentTime = chrono::system_clock::now();
-                this->memoryBlocks = (this->memoryBlocks > ((float) conf->getMemory()/(float) conf->getMemBlockSize())) ? 0 : this->memoryBlocks;
-                auto memory = this->memoryBlocks * conf->getMemBlockSize();
-
-                metaData.setStartTime(chrono::duration<double>(currentTime-START_TIME).count());
-                Log::output(*conf, to_string(metaData.getStartTime()) + " - " + "Process " + to_string(p.getProcessCount()) + ": " + "allocating memory");
-                metaData.setTime(this->processThread(timeLimit));
-                Log::output(*conf, to_string(metaData.getTime()) + " - " + "Process " + to_string(p.getProcessCount()) + ": " + "memory allocated at 0x" + this->generateMemoryLocation(memory));
-                // if there is not enough memory.
-                this->memoryBlocks++;
-                int totalBlocks = conf->getMemory()/conf->getMemBlockSize();
-                if(this->memoryBlocks > totalBlocks){
-                    this->memoryBlocks = 0;
-                }
-
-                p.setProcessState(Process::ProcessState::READY);
-            }else{
-                cerr << "Wrong descriptor for M" << endl;
-                exit(0);
-            }
+        const OperationEntry *entry = findOperation(metaData);
+        if(entry == NULL){
+            continue;
+        }
+        int cycleTime = (conf->*entry->cycleTime)();
+        p.setProcessState(Process::ProcessState::RUNNING);
+        if(entry->allocates){
+            // take a block before waiting so two processes never get the same one
+            auto memory = this->allocateMemory(conf);
+            metaData.setStartTime(this->logEvent(conf, "Process " + to_string(p.getProcessCount()) + ": " + "allocating memory"));
+            this->processThread(metaData.getCycles() + cycleTime);
+            metaData.setTime(this->logEvent(conf, "Process " + to_string(p.getProcessCount()) + ": " + "memory allocated at 0x" + this->generateMemoryLocation(memory)));
+        }else if(entry->semaphore != NULL){
+            // I/O waits for a free device, only the hard drive and printer count theirs
+            this->processIOOperation(metaData, conf, this->*entry->semaphore, this->*entry->lock,
+                                     entry->count != NULL ? this->*entry->count : noResources,
+                                     p.getProcessCount(), cycleTime, entry->print);
+        }else if(entry->lock != NULL){
+            // process, waiting for the processor if another process is on it
+            pthread_mutex_lock(&(this->*entry->lock));
+            this->processAction(entry->print, conf, metaData, p.getProcessCount(), cycleTime);
+            pthread_mutex_unlock(&(this->*entry->lock));
+        }else{
+            this->processAction(entry->print, conf, metaData, p.getProcessCount(), cycleTime);
         }
+        p.setProcessState(Process::ProcessState::READY);
     }
     this->processSystem("OS: removing process " + to_string(p.getProcessCount()), conf);
     p.setProcessState(Process::ProcessState::EXIT);
@@ -17,38 +17,101 @@
 #include <semaphore.h>
 #include <pthread.h>
 #include <chrono>
+#include <memory>
 
 #include "Config.h"
 #include "MetaData.h"
 #include "Process.h"
 #include "Log.h"
+#include "ProcessStream.h"
+#include "VirtualClock.h"
+#include "ProcessTask.h"
+#include "ReadyQueue.h"
 
 using namespace std;
 
+// ways the simulator can be run, picked with options after the .conf file
+struct RunOptions {
+    // schedule processes while the metadata file is still being read
+    bool streaming;
+    // use simulated time instead of waiting in real time
+    bool virtualClock;
+    // run every process on its own thread at the same time
+    bool concurrent;
+
+    RunOptions() : streaming(false), virtualClock(false), concurrent(false) {}
+};
+
 class OperatingSystem {
     public:
-        // initialize OP by reading in files, setting up threads, mutexes, and semaphores
-        OperatingSystem(Config*, string);
+        // initialize OP by reading in the metadata file, setting up threads, mutexes, and semaphores
+        OperatingSystem(shared_ptr<const Config>, RunOptions options = RunOptions());
+        ~OperatingSystem();
         // handles all P, I, O, M processes
-        void process(Process&, Config*);
+        void process(Process&, const Config*);
         // handles initiating and ending simulator
-        void processSystem(string, Config*);
+        void processSystem(string, const Config*);
         // resets memory
         void resetMemory();
         // queue with all processes
         deque<Process> getProcesses();
+        // adds streamed processes to the ready queue, false once nothing is left
+        bool admitProcesses(ReadyQueue&);
+        // starts every process in the queue in order and empties it, on its own thread or as a
+        // task on the simulated clock
+        void startProcesses(ReadyQueue&, const Config*);
+        // waits for every started process to finish, runs the simulated clock if there is one
+        void waitForProcesses();
 
     private:
-        // timer function
-        static void* timer(void*);
+        // a process running on its own thread
+        struct ProcessThread {
+            OperatingSystem *os;
+            Process process;
+            const Config *conf;
+            pthread_t thread;
+        };
+        // how an operation is run, one entry per code and descriptor. process() and the tasks on
+        // the simulated clock both look operations up here so they time and print them the same
+        struct OperationEntry {
+            char code;
+            const char *descriptor;
+            // time per cycle from the configuration file
+            int (Config::*cycleTime)() const;
+            // what a thread waits on, NULL for the ones it does not need
+            sem_t OperatingSystem::*semaphore;
+            pthread_mutex_t OperatingSystem::*lock;
+            int OperatingSystem::*count;
+            // what a task waits on, NULL if it needs nothing
+            SimResource SimDevices::*resource;
+            // printed after start and end
+            const char *print;
+            // takes a memory block and prints its address instead
+            bool allocates;
+        };
+        static const OperationEntry operationTable[];
+        // entry for an operation, NULL if it is not run like the S and A codes
+        static const OperationEntry *findOperation(const MetaData&);
+        // takes the next memory block
+        int allocateMemory(const Config*);
+        // thread body for a started process
+        static void *processRunner(void*);
+        // runs a task on the simulated clock until it has to wait
+        void resumeTask(ProcessTask*, const Config*);
+        // resource, time and output for an operation of a task, NULL if it needs no resource
+        SimResource *taskOperation(const MetaData&, const Config*, int&, string&, string&);
+        // stamps and prints a line, lines from every thread come out in time order
+        double logEvent(const Config*, const string&);
         //thread handling
         double processThread(int);
+        // time since the simulator started
+        double elapsed();
         // operating thread using mutex and semaphore
         void threadOperation(int, MetaData&, sem_t&, pthread_mutex_t&);
         // processes and prints I/O operations
-        void processIOOperation(MetaData, Config*, sem_t&, pthread_mutex_t&, int&, int, int, string);
+        void processIOOperation(MetaData, const Config*, sem_t&, pthread_mutex_t&, int&, int, int, string);
         // processes and prints operations besides I/O
-        void processAction(string, Config*, MetaData, int, int);
+        void processAction(string, const Config*, MetaData, int, int);
         //create memory location
         string generateMemoryLocation(int);
         // create starting time
@@ -65,12 +128,30 @@ class OperatingSystem {
         pthread_mutex_t mouseLock;
         pthread_mutex_t monitorLock;
         pthread_mutex_t keyboardLock;
+        // only one process runs on the processor at a time
+        pthread_mutex_t processorLock;
+        // guards memoryBlocks
+        pthread_mutex_t memoryLock;
+        // held while a line is stamped and printed
+        pthread_mutex_t logLock;
         //resource counters
         int harddriveCount;
         int printerCount;
         int memoryBlocks;
         // process queue
         deque<Process> processes;
+        // processes started by startProcesses, a deque so running threads keep their address
+        deque<ProcessThread> running;
+        // processes started on the simulated clock, a deque so tasks keep their address
+        deque<ProcessTask> tasks;
+        // processor and devices for the tasks, made when the first task starts
+        SimDevices *devices;
+        // metadata reader used when streaming
+        ProcessStream *stream;
+        // configuration shared with main
+        shared_ptr<const Config> config;
+        // simulated time, NULL when running in real time
+        VirtualClock *clock;
 
 
 };
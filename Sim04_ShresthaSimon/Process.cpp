@@ -10,6 +10,7 @@
  */
 #include <string>
 #include <deque>
+#include <vector>
 
 #include "Process.h"
 #include "MetaData.h"
@@ -45,14 +46,8 @@ void Process::createProcesses(deque<Process>& processes, deque<MetaData> operati
             }
 
             while(temp->getDescriptor() != "finish"){
-                // if I or O are seen, add one to IO count 
-                if(temp->getCode() == 'O' || temp->getCode() == 'I'){
-                    p.increaseIOCount();
-                }
-                //anything else add to task count 
-                p.increaseTaskCount();
-                // add to queue of tasks
-                p.push(*temp);
+                // add to queue of tasks and count it
+                p.addOperation(*temp);
                 //move to next item in MetaData queue 
                 advance(temp, 1);
             }
@@ -62,19 +57,68 @@ void Process::createProcesses(deque<Process>& processes, deque<MetaData> operati
         }
     }
 }
+/**
+ * @details: creates processes from a compiled metadata file. The file already has every
+ *           process split up and counted so the operations are only copied over. Each
+ *           descriptor is made into a string once and every operation copies its entry
+ * @param processes
+ *        queue of processes to fill
+ * @param metaBinary
+ *        mapped .mdb file
+ */
+void Process::createProcesses(deque<Process>& processes, const MetaBinary& metaBinary) {
+    vector<MetaData> descriptors;
+    for(uint32_t i = 0; i < metaBinary.getDescriptorCount(); i++){
+        descriptors.push_back(MetaData(0, metaBinary.getDescriptor(i), 0));
+    }
+    for(uint32_t i = 0; i < metaBinary.getProcessCount(); i++){
+        const MdbProcess &index = metaBinary.getProcess(i);
+        Process p;
+        p.setProcessCount(i + 1);
+        p.setIOCount(index.ioCount);
+        p.setTaskCount(index.taskCount);
+        for(uint32_t j = index.firstOperation; j < index.firstOperation + index.operationCount; j++){
+            const MdbOperation &op = metaBinary.getOperation(j);
+            MetaData operation(descriptors[op.descriptor]);
+            operation.setCode(op.code);
+            operation.setCycles(op.cycles);
+            p.push(operation);
+        }
+        processes.push_back(p);
+    }
+}
 // adds process to end of queue 
 void Process::push(MetaData metaData) {
     this->operations.push_back(metaData);
 }
 
+// adds an operation to the end of queue and updates the IO and task counts
+void Process::addOperation(MetaData metaData) {
+    // if I or O are seen, add one to IO count
+    if(metaData.getCode() == 'O' || metaData.getCode() == 'I'){
+        this->increaseIOCount();
+    }
+    //anything else add to task count
+    this->increaseTaskCount();
+    this->push(metaData);
+}
+
 //increases IO count
 void Process::increaseIOCount() {
     this->numOfIO++;
 }
+//sets IO count
+void Process::setIOCount(int count) {
+    this->numOfIO = count;
+}
 //increases regular task count
 void Process::increaseTaskCount() {
     this->numOfTasks++;
 }
+//sets regular task count
+void Process::setTaskCount(int count) {
+    this->numOfTasks = count;
+}
 // increases counter for number of processes
 void Process::setProcessCount(int count) {
     this->processCount = count;
@@ -105,11 +149,11 @@ void Process::setProcessState(Process::ProcessState stateChange) {
     this->processState = stateChange;
 }
 //get the number of IO operations 
-int Process::getIOCount() {
+int Process::getIOCount() const {
     return this->numOfIO;
 }
 //get number of tasks
-int Process::getTaskCount() {
+int Process::getTaskCount() const {
     return this->numOfTasks;
 }
 
@@ -16,6 +16,7 @@
 #include <deque>
 
 #include "MetaData.h"
+#include "MetaBinary.h"
 #include "Config.h"
 using namespace std;
 
@@ -26,13 +27,18 @@ class Process {
         enum class ProcessState { START, READY, RUNNING, WAIT, EXIT };
         // associated each task as either IO or not to help count for sceduling algorithms
         static void createProcesses(deque<Process>&, deque<MetaData>);
+        // creates processes from the process index of a compiled metadata file
+        static void createProcesses(deque<Process>&, const MetaBinary&);
         void push(MetaData);
+        void addOperation(MetaData);
 
         void increaseIOCount();
-        int getIOCount();
+        void setIOCount(int);
+        int getIOCount() const;
 
         void increaseTaskCount();
-        int getTaskCount();
+        void setTaskCount(int);
+        int getTaskCount() const;
 
         void setProcessCount(int);
         int getProcessCount();
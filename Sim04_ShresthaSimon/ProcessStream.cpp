@@ -0,0 +1,234 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file ProcessStream.cpp
+ *
+ * @brief implementation file for process stream class
+ *
+ * @details parses the metadata file in bounded chunks and queues up finished processes
+ *
+ */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <deque>
+#include <vector>
+#include <pthread.h>
+
+#include "ProcessStream.h"
+#include "MetaData.h"
+#include "Process.h"
+#include "Tokenizer.h"
+using namespace std;
+
+// appends text to a word, carriage returns are left out
+static void appendText(string &word, const char *begin, const char *end) {
+    for(const char *pos = begin; pos != end; pos++){
+        if(*pos != '\r'){
+            word.append(1, *pos);
+        }
+    }
+}
+
+// constructor that sets up the queue, nothing is read until start is called
+ProcessStream::ProcessStream(string filePath) {
+    this->filePath = filePath;
+    this->started = false;
+    this->done = false;
+    this->inProcess = false;
+    this->numOfProcesses = 1;
+    pthread_mutex_init(&this->queueLock, NULL);
+    pthread_cond_init(&this->notEmpty, NULL);
+    pthread_cond_init(&this->notFull, NULL);
+}
+
+// waits for the reader before destroying the locks
+ProcessStream::~ProcessStream() {
+    if(this->started){
+        pthread_join(this->readerThread, NULL);
+    }
+    pthread_mutex_destroy(&this->queueLock);
+    pthread_cond_destroy(&this->notEmpty);
+    pthread_cond_destroy(&this->notFull);
+}
+
+/**
+ * @details: creates the reader thread that fills the queue
+ */
+void ProcessStream::start() {
+    this->started = true;
+    pthread_create(&this->readerThread, NULL, ProcessStream::reader, this);
+}
+
+/**
+ * @details: waits until a process is parsed or the file is done
+ * @param p
+ *        process that was taken off the queue
+ * @return
+ *        false if there are no processes left
+ */
+bool ProcessStream::next(Process &p) {
+    pthread_mutex_lock(&this->queueLock);
+    while(this->ready.empty() && !this->done){
+        pthread_cond_wait(&this->notEmpty, &this->queueLock);
+    }
+    if(this->ready.empty()){
+        pthread_mutex_unlock(&this->queueLock);
+        return false;
+    }
+    p = this->ready.front();
+    this->ready.pop_front();
+    pthread_cond_signal(&this->notFull);
+    pthread_mutex_unlock(&this->queueLock);
+    return true;
+}
+
+/**
+ * @details: takes a process off the queue without waiting
+ * @param p
+ *        process that was taken off the queue
+ * @return
+ *        false if nothing has been parsed yet
+ */
+bool ProcessStream::tryNext(Process &p) {
+    pthread_mutex_lock(&this->queueLock);
+    if(this->ready.empty()){
+        pthread_mutex_unlock(&this->queueLock);
+        return false;
+    }
+    p = this->ready.front();
+    this->ready.pop_front();
+    pthread_cond_signal(&this->notFull);
+    pthread_mutex_unlock(&this->queueLock);
+    return true;
+}
+
+// reader thread function
+void* ProcessStream::reader(void *stream) {
+    static_cast<ProcessStream*>(stream)->readFile();
+    return NULL;
+}
+
+/**
+ * @details: reads the metadata file one chunk at a time. Words are split on ; and the
+ *           file ends on the period, so a word can be cut between two chunks
+ */
+void ProcessStream::readFile() {
+    ifstream metaFile;
+    vector<char> buffer(CHUNK_SIZE);
+    string line;
+    string word;
+    // 0 reading words, 1 skipping the rest of the period line, 2 reading the closing line,
+    // 3 past the closing line
+    int state = 0;
+
+    // open file and get first line and check if it is correct
+    metaFile.open(this->filePath);
+    getline(metaFile, line);
+    if(line != "Start Program Meta-Data Code:"){
+        cerr << "Error! Meta Data File is not formatted correctly" << endl;
+        exit(0);
+    }
+    line.erase();
+
+    while(metaFile.read(buffer.data(), CHUNK_SIZE) || metaFile.gcount() > 0){
+        int size = metaFile.gcount();
+        const char *chunkEnd = buffer.data() + size;
+        int i = 0;
+        if(state == 0){
+            // jump straight between delimiters instead of checking every byte
+            const char *wordStart = buffer.data();
+            Tokenizer tokenizer(wordStart, chunkEnd);
+            for(const char *pos = tokenizer.next(); state == 0; pos = tokenizer.next()){
+                appendText(word, wordStart, pos);
+                if(pos == chunkEnd){
+                    wordStart = chunkEnd;
+                    break;
+                }
+                if(*pos == ';'){
+                    this->handleWord(word);
+                }else if(*pos == '.'){
+                    this->handleWord(word);
+                    state = 1;
+                }
+                // braces stay part of the word, new lines are dropped
+                if(*pos == '{' || *pos == '}'){
+                    word.append(1, *pos);
+                }
+                wordStart = pos + 1;
+            }
+            i = wordStart - buffer.data();
+        }
+        for(; i < size; i++){
+            char c = buffer[i];
+            if(state == 1){
+                if(c == '\n'){
+                    state = 2;
+                }
+            }else if(state == 3){
+                // only blank space may follow the closing line
+                if(c != '\n' && c != '\r' && c != ' ' && c != '\t'){
+                    cerr << "Error! Unexpected text after End Program Meta-Data Code." << endl;
+                    exit(0);
+                }
+            }else if(c != '\n'){
+                line.append(1, c);
+            }else if(!line.empty()){
+                state = 3;
+            }
+        }
+    }
+    metaFile.close();
+
+    // get the last line of check if it is the correct line
+    if(state < 2 || line != "End Program Meta-Data Code."){
+        cerr << "Error! Meta Data File is not formatted correctly" << endl;
+        exit(0);
+    }
+
+    this->finish();
+}
+
+/**
+ * @details: builds the operation for a word and adds it to the process being read
+ * @param word
+ *        word read from the file, emptied afterwards
+ */
+void ProcessStream::handleWord(string &word) {
+    MetaData operation = MetaData::buildOperation(word);
+    word.erase();
+
+    if(operation.getCode() == 'A' && operation.getDescriptor() == "begin"){
+        // start a new process
+        this->current = Process();
+        this->current.setProcessCount(this->numOfProcesses++);
+        this->inProcess = true;
+    }else if(operation.getDescriptor() == "finish"){
+        // the process is complete so hand it over
+        if(this->inProcess){
+            this->pushProcess(this->current);
+            this->inProcess = false;
+        }
+    }else if(this->inProcess){
+        this->current.addOperation(operation);
+    }
+}
+
+// adds a process to the queue, waits while the queue is full
+void ProcessStream::pushProcess(Process &p) {
+    pthread_mutex_lock(&this->queueLock);
+    while((int) this->ready.size() >= QUEUE_CAPACITY){
+        pthread_cond_wait(&this->notFull, &this->queueLock);
+    }
+    this->ready.push_back(p);
+    pthread_cond_signal(&this->notEmpty);
+    pthread_mutex_unlock(&this->queueLock);
+}
+
+// wakes anyone waiting once there is nothing left to read
+void ProcessStream::finish() {
+    pthread_mutex_lock(&this->queueLock);
+    this->done = true;
+    pthread_cond_broadcast(&this->notEmpty);
+    pthread_mutex_unlock(&this->queueLock);
+}
@@ -0,0 +1,69 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file ProcessStream.h
+ *
+ * @brief header for process stream class
+ *
+ * @details reads the metadata file in fixed size chunks on its own thread and hands
+ *          each A{begin} ... A{finish} block to the scheduler as soon as it is parsed
+ *
+ */
+#ifndef CS446PROJ4_PROCESSSTREAM_H
+#define CS446PROJ4_PROCESSSTREAM_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <deque>
+#include <pthread.h>
+
+#include "MetaData.h"
+#include "Process.h"
+using namespace std;
+
+class ProcessStream {
+    public:
+        // size of each chunk read from the metadata file
+        static const int CHUNK_SIZE = 64 * 1024;
+        // processes that can be parsed ahead of the scheduler
+        static const int QUEUE_CAPACITY = 64;
+
+        ProcessStream(string);
+        ~ProcessStream();
+        // starts the reader thread
+        void start();
+        // waits for the next process, false once the file is done
+        bool next(Process&);
+        // takes the next process only if one is already parsed
+        bool tryNext(Process&);
+
+    private:
+        // reader thread
+        static void* reader(void*);
+        // reads the file chunk by chunk
+        void readFile();
+        // handles one word of the file
+        void handleWord(string&);
+        // adds a finished process to the queue, waits if the queue is full
+        void pushProcess(Process&);
+        // marks the file as done
+        void finish();
+
+        string filePath;
+        pthread_t readerThread;
+        bool started;
+        //queue of processes parsed but not yet scheduled
+        deque<Process> ready;
+        bool done;
+        pthread_mutex_t queueLock;
+        pthread_cond_t notEmpty;
+        pthread_cond_t notFull;
+        //process currently being read
+        Process current;
+        bool inProcess;
+        int numOfProcesses;
+};
+
+
+#endif //CS446PROJ4_PROCESSSTREAM_H
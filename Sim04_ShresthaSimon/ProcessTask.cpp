@@ -0,0 +1,80 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file ProcessTask.cpp
+ *
+ * @brief implementation file for processes run on the simulated clock
+ *
+ * @details only the clock thread touches these, so nothing here is locked
+ *
+ */
+#include <queue>
+#include <vector>
+
+#include "ProcessTask.h"
+using namespace std;
+
+/**
+ * @details: sets up a resource with every unit free
+ * @param units
+ *        how many of the resource there are
+ */
+SimResource::SimResource(int units) {
+    this->units = units;
+    this->nextOrder = 0;
+}
+
+/**
+ * @details: takes a free unit or puts the task in line for one
+ * @param task
+ *        task that wants the resource
+ * @param priority
+ *        place in line, lower goes first
+ * @return
+ *        true if the task got a unit
+ */
+bool SimResource::acquire(ProcessTask *task, int priority) {
+    if(this->units > 0){
+        this->units--;
+        return true;
+    }
+    Waiter waiter;
+    waiter.priority = priority;
+    waiter.order = this->nextOrder++;
+    waiter.task = task;
+    this->waiting.push(waiter);
+    return false;
+}
+
+/**
+ * @details: hands the unit straight to the next waiter so nobody can take it in between
+ * @return
+ *        task that now holds the unit, NULL if the unit is free
+ */
+ProcessTask *SimResource::release() {
+    if(this->waiting.empty()){
+        this->units++;
+        return NULL;
+    }
+    ProcessTask *task = this->waiting.top().task;
+    this->waiting.pop();
+    return task;
+}
+
+// lower priority first, then the order they came in
+bool SimResource::Later::operator()(const Waiter &a, const Waiter &b) const {
+    if(a.priority != b.priority){
+        return a.priority > b.priority;
+    }
+    return a.order > b.order;
+}
+
+// one processor, devices with a quantity in the configuration file get that many units
+SimDevices::SimDevices(const Config *conf)
+    : processor(1),
+      harddrive(conf->getHarddriveResources()),
+      printer(conf->getPrinterResources()),
+      keyboard(1),
+      mouse(1),
+      monitor(1) {
+}
@@ -0,0 +1,78 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file ProcessTask.h
+ *
+ * @brief header for processes run on the simulated clock
+ *
+ * @details a process on the simulated clock has no thread of its own. It remembers which
+ *          operation it is on, and each operation schedules the event that resumes the process
+ *          when the operation ends, so any number of processes can run on the one clock thread
+ *
+ */
+#ifndef CS446PROJ4_PROCESSTASK_H
+#define CS446PROJ4_PROCESSTASK_H
+
+#include <queue>
+#include <vector>
+
+#include "Config.h"
+#include "Process.h"
+using namespace std;
+
+struct ProcessTask;
+
+// a processor or device in simulated time, tasks that find every unit in use wait here
+class SimResource {
+    public:
+        SimResource(int);
+        // takes a unit for the task, false if the task has to wait for one
+        bool acquire(ProcessTask*, int);
+        // gives a unit back, the task it was handed to is returned or NULL if nobody was waiting
+        ProcessTask *release();
+
+    private:
+        struct Waiter {
+            // lower goes first
+            int priority;
+            // waiters with the same priority go in the order they came in
+            unsigned long long order;
+            ProcessTask *task;
+        };
+        // orders the queue so the next waiter is on top
+        struct Later {
+            bool operator()(const Waiter&, const Waiter&) const;
+        };
+
+        int units;
+        unsigned long long nextOrder;
+        priority_queue<Waiter, vector<Waiter>, Later> waiting;
+};
+
+// the processor and every device, unit counts come from the configuration file
+struct SimDevices {
+    SimResource processor;
+    SimResource harddrive;
+    SimResource printer;
+    SimResource keyboard;
+    SimResource mouse;
+    SimResource monitor;
+
+    SimDevices(const Config*);
+};
+
+// where a process is up to
+struct ProcessTask {
+    Process process;
+    // operations of the process, copied once so every step does not copy them again
+    deque<MetaData> operations;
+    // index of the operation to run next
+    size_t next;
+    // place the scheduler put the process in, lower gets the processor first
+    int rank;
+    // resource handed to the task while it was waiting, NULL otherwise
+    SimResource *held;
+};
+
+
+#endif //CS446PROJ4_PROCESSTASK_H
@@ -0,0 +1,146 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file ReadyQueue.cpp
+ *
+ * @brief implementation file for ready queue class
+ *
+ * @details keys are worked out once when a process is pushed, so comparing two processes in
+ *          the heap never copies or walks their operations
+ *
+ */
+#include <vector>
+#include <utility>
+
+#include "Process.h"
+#include "ReadyQueue.h"
+using namespace std;
+
+/**
+ * @details: makes an empty queue
+ * @param key
+ *        function giving the key of a process
+ */
+ReadyQueue::ReadyQueue(KeyFunction key) {
+    this->key = key;
+    this->nextOrder = 0;
+}
+
+/**
+ * @details: adds a process and moves it up to its place
+ * @param process
+ * @return
+ *        handle that can be passed to setKey
+ */
+int ReadyQueue::push(const Process &process) {
+    int handle;
+    if(this->freeHandles.empty()){
+        handle = this->entries.size();
+        this->entries.push_back(Entry());
+    }else{
+        handle = this->freeHandles.back();
+        this->freeHandles.pop_back();
+    }
+    Entry &entry = this->entries[handle];
+    entry.process = process;
+    entry.key = this->key(process);
+    entry.order = this->nextOrder++;
+
+    this->heap.push_back(handle);
+    entry.position = this->heap.size() - 1;
+    this->siftUp(entry.position);
+    return handle;
+}
+
+/**
+ * @details: takes the top of the heap and fills the gap with the last process
+ * @return
+ *        the process with the lowest key
+ */
+Process ReadyQueue::pop() {
+    int handle = this->heap.front();
+    Process process = move(this->entries[handle].process);
+    this->entries[handle].process = Process();
+    this->freeHandles.push_back(handle);
+
+    this->place(0, this->heap.back());
+    this->heap.pop_back();
+    if(!this->heap.empty()){
+        this->siftDown(0);
+    }
+    return process;
+}
+
+/**
+ * @details: changes the key of a waiting process and moves it to its new place
+ * @param handle
+ *        handle returned by push
+ * @param key
+ *        the new key
+ */
+void ReadyQueue::setKey(int handle, long long key) {
+    Entry &entry = this->entries[handle];
+    long long old = entry.key;
+    entry.key = key;
+    if(key < old){
+        this->siftUp(entry.position);
+    }else{
+        this->siftDown(entry.position);
+    }
+}
+
+bool ReadyQueue::empty() const {
+    return this->heap.empty();
+}
+
+size_t ReadyQueue::size() const {
+    return this->heap.size();
+}
+
+// lower key first, then the order they were pushed in
+bool ReadyQueue::before(int a, int b) const {
+    const Entry &first = this->entries[a];
+    const Entry &second = this->entries[b];
+    if(first.key != second.key){
+        return first.key < second.key;
+    }
+    return first.order < second.order;
+}
+
+void ReadyQueue::siftUp(size_t index) {
+    int handle = this->heap[index];
+    while(index > 0){
+        size_t parent = (index - 1) / 2;
+        if(!this->before(handle, this->heap[parent])){
+            break;
+        }
+        this->place(index, this->heap[parent]);
+        index = parent;
+    }
+    this->place(index, handle);
+}
+
+void ReadyQueue::siftDown(size_t index) {
+    int handle = this->heap[index];
+    size_t count = this->heap.size();
+    while(true){
+        size_t child = 2 * index + 1;
+        if(child >= count){
+            break;
+        }
+        if(child + 1 < count && this->before(this->heap[child + 1], this->heap[child])){
+            child++;
+        }
+        if(!this->before(this->heap[child], handle)){
+            break;
+        }
+        this->place(index, this->heap[child]);
+        index = child;
+    }
+    this->place(index, handle);
+}
+
+void ReadyQueue::place(size_t index, int handle) {
+    this->heap[index] = handle;
+    this->entries[handle].position = index;
+}
@@ -0,0 +1,65 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file ReadyQueue.h
+ *
+ * @brief header for ready queue class
+ *
+ * @details processes waiting for the processor are kept in a binary heap ordered by a key the
+ *          scheduler picks, so adding, removing and re-keying a process is O(log n) and
+ *          processes can be added while others are already running
+ *
+ */
+#ifndef CS446PROJ4_READYQUEUE_H
+#define CS446PROJ4_READYQUEUE_H
+
+#include <vector>
+
+#include "Process.h"
+using namespace std;
+
+class ReadyQueue {
+    public:
+        // key a process is ordered by, lower keys come out first
+        typedef long long (*KeyFunction)(const Process&);
+
+        ReadyQueue(KeyFunction);
+        // adds a process, the handle stays valid until the process is popped
+        int push(const Process&);
+        // takes out the process with the lowest key, processes with the same key come out in
+        // the order they were pushed
+        Process pop();
+        // changes the key of a process that is still waiting
+        void setKey(int, long long);
+
+        bool empty() const;
+        size_t size() const;
+
+    private:
+        struct Entry {
+            Process process;
+            long long key;
+            // order the process was pushed in
+            unsigned long long order;
+            // index of the entry in the heap
+            size_t position;
+        };
+
+        // true if the first handle should come out before the second
+        bool before(int, int) const;
+        void siftUp(size_t);
+        void siftDown(size_t);
+        // puts a handle at a heap index and remembers where it is
+        void place(size_t, int);
+
+        KeyFunction key;
+        // entries indexed by handle, handles of popped processes are reused
+        vector<Entry> entries;
+        vector<int> freeHandles;
+        // heap of handles
+        vector<int> heap;
+        unsigned long long nextOrder;
+};
+
+
+#endif //CS446PROJ4_READYQUEUE_H
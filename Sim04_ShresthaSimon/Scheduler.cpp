@@ -11,10 +11,10 @@
 #include <iostream>
 #include <string>
 #include <deque>
-#include <algorithm>
 
 #include "Config.h"
 #include "Process.h"
+#include "ReadyQueue.h"
 #include "Scheduler.h"
 using namespace std;
 
@@ -22,47 +22,41 @@ using namespace std;
  * @details: decides on which scheduling algorithm to use depending on input from configuration file
  * @param conf
  *        configuration class
- * @param processes
- *        queue of processes
+ * @return
+ *        key function for the ready queue
  */
-void Scheduler::scheduleProcess(Config* conf, deque<Process> &processes) {
+ReadyQueue::KeyFunction Scheduler::scheduleProcess(const Config* conf) {
     //if empty then return error
     if(conf->getSchedulingAlgorithm() == ""){
         cerr << "No scheduling algorithm selected" << endl;
         exit(0);
     }
 
-    // if FIFO then do nothing because it is already in order
     if(conf->getSchedulingAlgorithm() == "FIFO"){
-
+        // if FIFO then keep the order the processes arrived in
+        return arrival;
     }else if(conf->getSchedulingAlgorithm() == "PS"){
-        // if PS then sort using priority
-        priority(processes);
+        // if PS then order using priority
+        return priority;
     }else if(conf->getSchedulingAlgorithm() == "SJF"){
-        //if SJF then sort using IO count
-        shortestJobFirst(processes);
-    }else{
-        cerr << "Not a valid scheduling algorithm" << endl;
-        exit(0);
+        //if SJF then order using task count
+        return shortestJobFirst;
     }
+    cerr << "Not a valid scheduling algorithm" << endl;
+    exit(0);
 }
 
-// sorts queue using IO count
-void Scheduler::priority(deque<Process> &processes) {
-    sort(processes.begin(), processes.end(), sortByPriority);
-}
-
-//sorts queue using task count
-void Scheduler::shortestJobFirst(deque<Process> &processes) {
-    sort(processes.begin(), processes.end(), sortByShortest);
+// every process has the same key
+long long Scheduler::arrival(const Process &process) {
+    return 0;
 }
 
-//using IO count to compare processes
-bool Scheduler::sortByPriority(Process p1, Process p2) {
-    return p1.getIOCount() > p2.getIOCount();
+// using IO count to order processes, negated so the most IO comes out first
+long long Scheduler::priority(const Process &process) {
+    return -(long long) process.getIOCount();
 }
 
-//using task count to sort processes
-bool Scheduler::sortByShortest(Process p1, Process p2) {
-    return p1.getTaskCount() < p2.getTaskCount();
+//using task count to order processes
+long long Scheduler::shortestJobFirst(const Process &process) {
+    return process.getTaskCount();
 }
@@ -17,22 +17,21 @@
 
 #include "Config.h"
 #include "Process.h"
+#include "ReadyQueue.h"
 using namespace std;
 
 class Scheduler {
     public:
-        //decide on which scheduling algorithm
-        static void scheduleProcess(Config*, deque<Process>&);
+        //decide on which scheduling algorithm, gives the key the ready queue orders processes by
+        static ReadyQueue::KeyFunction scheduleProcess(const Config*);
 
     private:
-        //sort processes by PS
-        static void priority(deque<Process>&);
-        // sort processes by SJF
-        static void shortestJobFirst(deque<Process>&);
-        // compare processes depending on IO count
-        static bool sortByPriority(Process, Process);
-        // compare processes depending on task count
-        static bool sortByShortest(Process, Process);
+        // FIFO keeps every process on the same key so they come out in order
+        static long long arrival(const Process&);
+        // order processes by PS, more IO goes first
+        static long long priority(const Process&);
+        // order processes by SJF, fewer tasks go first
+        static long long shortestJobFirst(const Process&);
 
 };
 
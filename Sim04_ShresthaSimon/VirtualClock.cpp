@@ -0,0 +1,88 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file VirtualClock.cpp
+ *
+ * @brief implementation file for discrete event clock class
+ *
+ * @details time is kept in whole microseconds so the same run always prints the same times
+ *
+ */
+#include <queue>
+#include <vector>
+#include <functional>
+
+#include "VirtualClock.h"
+using namespace std;
+
+// the clock starts at 0 with nothing scheduled
+VirtualClock::VirtualClock() {
+    this->currentTime = 0;
+    this->nextOrder = 0;
+}
+
+/**
+ * @details: current simulated time
+ * @return
+ *        seconds since the simulation started
+ */
+double VirtualClock::now() const {
+    return this->currentTime / 1000000.0;
+}
+
+/**
+ * @details: adds an event to the queue
+ * @param delay
+ *        milliseconds from now that the event happens
+ * @param action
+ *        what to run when the event happens
+ */
+void VirtualClock::schedule(int delay, function<void()> action) {
+    Event event;
+    event.time = this->currentTime + (long long) delay * 1000;
+    event.order = this->nextOrder++;
+    event.action = action;
+    this->events.push(event);
+}
+
+/**
+ * @details: takes the earliest event off the queue, moves the clock to it and runs it
+ * @return
+ *        false if there was nothing to run
+ */
+bool VirtualClock::step() {
+    if(this->events.empty()){
+        return false;
+    }
+    Event event = this->events.top();
+    this->events.pop();
+    this->currentTime = event.time;
+    event.action();
+    return true;
+}
+
+// runs every event, including ones added while running
+void VirtualClock::run() {
+    while(this->step()){
+    }
+}
+
+/**
+ * @details: waits in simulated time, anything scheduled before the wait is over runs first
+ * @param delay
+ *        milliseconds to wait
+ */
+void VirtualClock::advance(int delay) {
+    bool done = false;
+    this->schedule(delay, [&done]() { done = true; });
+    while(!done && this->step()){
+    }
+}
+
+// earlier times first, then the order they were scheduled in
+bool VirtualClock::Later::operator()(const Event &a, const Event &b) const {
+    if(a.time != b.time){
+        return a.time > b.time;
+    }
+    return a.order > b.order;
+}
@@ -0,0 +1,54 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file VirtualClock.h
+ *
+ * @brief header for discrete event clock class
+ *
+ * @details keeps simulated time instead of reading the wall clock. Events are kept in a
+ *          priority queue by the time they happen and running an event moves the clock
+ *          straight to that time, so waiting for an operation takes no real time
+ *
+ */
+#ifndef CS446PROJ4_VIRTUALCLOCK_H
+#define CS446PROJ4_VIRTUALCLOCK_H
+
+#include <queue>
+#include <vector>
+#include <functional>
+using namespace std;
+
+class VirtualClock {
+    public:
+        VirtualClock();
+        // seconds since the simulation started
+        double now() const;
+        // adds an event that runs a number of milliseconds from now
+        void schedule(int, function<void()>);
+        // runs the next event and moves the clock to its time, false if there are none
+        bool step();
+        // runs events until there are none left
+        void run();
+        // moves the clock forward a number of milliseconds, running every event due before then
+        void advance(int);
+
+    private:
+        struct Event {
+            // microseconds since the simulation started
+            long long time;
+            // events at the same time run in the order they were scheduled
+            unsigned long long order;
+            function<void()> action;
+        };
+        // orders the queue so the earliest event is on top
+        struct Later {
+            bool operator()(const Event&, const Event&) const;
+        };
+
+        priority_queue<Event, vector<Event>, Later> events;
+        long long currentTime;
+        unsigned long long nextOrder;
+};
+
+
+#endif //CS446PROJ4_VIRTUALCLOCK_H
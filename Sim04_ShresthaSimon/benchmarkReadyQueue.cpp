@@ -0,0 +1,127 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file benchmarkReadyQueue.cpp
+ *
+ * @brief ready queue benchmark
+ *
+ * @details orders 1M processes for SJF two ways. The old scheduler sorted the whole queue
+ *          with a comparison that took both processes by value, so every comparison copied
+ *          their operations. The ready queue works the key out once per process and keeps a
+ *          heap of handles. Also times admitting processes while others are being taken out,
+ *          which the sort could only do by sorting the whole queue again
+ *
+ * @note requires Process, MetaData and ReadyQueue class files
+ */
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+#include "MetaData.h"
+#include "Process.h"
+#include "ReadyQueue.h"
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// seconds since start
+static double elapsed(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// how the scheduler used to compare processes for SJF
+static bool sortByShortest(Process p1, Process p2) {
+    return p1.getTaskCount() < p2.getTaskCount();
+}
+
+// SJF key of the ready queue
+static long long shortestJobFirst(const Process &process) {
+    return process.getTaskCount();
+}
+
+// makes processes of 1 to 15 operations
+static void makeProcesses(deque<Process> &processes, long count) {
+    static const char *const descriptors[] = {"run", "hard drive", "monitor", "allocate"};
+    static const char codes[] = {'P', 'I', 'O', 'M'};
+    mt19937 random(1);
+    for(long i = 0; i < count; i++){
+        Process p;
+        p.setProcessCount(i + 1);
+        int operations = 1 + random() % 15;
+        for(int j = 0; j < operations; j++){
+            int kind = random() % 4;
+            p.addOperation(MetaData(codes[kind], descriptors[kind], 1 + random() % 10));
+        }
+        processes.push_back(p);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    long count = 1000000;
+    if(argc == 2 && atol(argv[1]) > 0){
+        count = atol(argv[1]);
+    }else if(argc != 1){
+        cerr << "Error! Usage: ./benchmarkReadyQueue [processes]" << endl;
+        return 0;
+    }
+
+    deque<Process> processes;
+    makeProcesses(processes, count);
+    cout << fixed << setprecision(3);
+    cout << count << " processes" << endl;
+
+    // the old path, sorting a copy of the queue
+    {
+        deque<Process> sorted(processes);
+        Clock::time_point start = Clock::now();
+        sort(sorted.begin(), sorted.end(), sortByShortest);
+        cout << setw(36) << left << "sort, processes compared by value" << right << setw(10) << elapsed(start) << " s" << endl;
+    }
+
+    // every process pushed then every process popped
+    {
+        ReadyQueue ready(shortestJobFirst);
+        Clock::time_point start = Clock::now();
+        for(const Process &process : processes){
+            ready.push(process);
+        }
+        long last = 0;
+        while(!ready.empty()){
+            Process process = ready.pop();
+            if(process.getTaskCount() < last){
+                cerr << "Error, ready queue came out of order" << endl;
+                return 0;
+            }
+            last = process.getTaskCount();
+        }
+        cout << setw(36) << left << "ready queue, push all then pop all" << right << setw(10) << elapsed(start) << " s" << endl;
+    }
+
+    // processes keep arriving while the processor takes one for every two that arrive
+    {
+        ReadyQueue ready(shortestJobFirst);
+        Clock::time_point start = Clock::now();
+        long popped = 0;
+        for(long i = 0; i < count; i++){
+            ready.push(processes[i]);
+            if(i % 2 == 1){
+                ready.pop();
+                popped++;
+            }
+        }
+        while(!ready.empty()){
+            ready.pop();
+            popped++;
+        }
+        double time = elapsed(start);
+        cout << setw(36) << left << "ready queue, admitted while running" << right << setw(10) << time << " s, "
+             << time * 1e6 / (count + popped) << " usec per push or pop" << endl;
+    }
+    return 0;
+}
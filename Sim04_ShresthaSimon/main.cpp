@@ -17,45 +17,73 @@
 #include "Log.h"
 #include "OperatingSystem.h"
 #include "Process.h"
+#include "ReadyQueue.h"
 #include "Scheduler.h"
 
 int main(int argc, char* argv[]){
 
     //checks if an argument was passed in
-    if(argc != 2){
+    if(argc < 2){
         cerr << "Error! You must use a .conf file as an input for this application." << endl;
         return 0;
     }
 
+    // optional run modes after the .conf file
+    RunOptions options;
+    for(int i = 2; i < argc; i++){
+        if(string(argv[i]) == "--stream"){
+            options.streaming = true;
+        }else if(string(argv[i]) == "--virtual-clock"){
+            options.virtualClock = true;
+        }else if(string(argv[i]) == "--concurrent"){
+            options.concurrent = true;
+        }else{
+            cerr << "Error! Unknown option " << argv[i] << endl;
+            return 0;
+        }
+    }
+
     //reads in first argument as file and checks if it is a .conf file
     string file(argv[1]);
-    Config conf;
 
     if(file.substr(file.find_first_of(".") + 1) != "conf") {
         cerr << "Error! Only a .conf file is applicable as the argument." << endl;
         return 0;
     }
-    // reads configuration and metadata file and initializes everything including
-    // mutexes and semaphores.
-    OperatingSystem os(&conf, file);
-
-    //creates a queue of all the tasks created from reading metadata file
-    auto processQueue = os.getProcesses();
+    // reads configuration file, the configuration can not change after this
+    shared_ptr<const Config> conf = Config::load(file);
+    // reads metadata file and initializes everything including mutexes and semaphores.
+    OperatingSystem os(conf, options);
 
     //starts the program
-    os.processSystem("Simulator program starting", &conf);
+    os.processSystem("Simulator program starting", conf.get());
 
-    //orders the processes depending the scheduling algorithm chosen
-    Scheduler::scheduleProcess(&conf, processQueue);
+    //processes waiting for the processor, ordered depending the scheduling algorithm chosen
+    ReadyQueue processQueue(Scheduler::scheduleProcess(conf.get()));
+    //queues all the tasks created from reading metadata file
+    for(auto &process: os.getProcesses()){
+        processQueue.push(process);
+    }
 
-    // runs the process
-    for(auto process: processQueue){
-        // will also reset memory if there is not enough
-        os.process(process, &conf);
+    if(options.concurrent){
+        // every process starts as soon as it is admitted and runs alongside the others, as a
+        // thread or as a task on the simulated clock
+        while(os.admitProcesses(processQueue)){
+            os.startProcesses(processQueue, conf.get());
+        }
+        os.waitForProcesses();
+    }else{
+        // takes the next process each time the processor is free, when streaming whatever has
+        // been parsed since is queued first
+        while(os.admitProcesses(processQueue)){
+            Process process = processQueue.pop();
+            // will also reset memory if there is not enough
+            os.process(process, conf.get());
+        }
     }
 
     //ends the program
-    os.processSystem("Simulator program ending", &conf);
+    os.processSystem("Simulator program ending", conf.get());
 
     //reset memory after program ends
     os.resetMemory();
@@ -0,0 +1,44 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file mdfc.cpp
+ *
+ * @brief metadata compiler
+ *
+ * @details reads a .mdf file once and writes it out as a .mdb file that the simulator
+ *          can map without parsing
+ *
+ * @note requires MetaData and MetaBinary class files
+ */
+#include <iostream>
+#include <string>
+#include <deque>
+
+#include "MetaData.h"
+#include "MetaBinary.h"
+using namespace std;
+
+int main(int argc, char* argv[]){
+
+    //checks if an input and output file were passed in
+    if(argc != 3){
+        cerr << "Error! Usage: ./mdfc input.mdf output.mdb" << endl;
+        return 0;
+    }
+
+    string input(argv[1]);
+    string output(argv[2]);
+
+    if(!MetaBinary::isBinaryPath(output)){
+        cerr << "Error! The output file has to be a .mdb file." << endl;
+        return 0;
+    }
+
+    // parse the text file the same way the simulator does
+    deque<MetaData> operations;
+    MetaData::readMetaFile(input, operations);
+
+    MetaBinary::compile(operations, output);
+
+    return 0;
+}
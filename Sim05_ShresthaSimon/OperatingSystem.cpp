@@ -9,6 +9,11 @@
  *
  */
 #include "OperatingSystem.h"
+#include "schedulerPolicy.h"
+#include "timerService.h"
+#include "workerPool.h"
+#include <cerrno>
+#include <sstream>
 using namespace std;
 
 //global variables
@@ -17,18 +22,19 @@ bool write = false;
 bool print = false;
 bool rrCall = false;
 int loadCount = 0;
+//times the program is loaded again after the first time
+static const int LOAD_LIMIT = 4;
+//most processors a configuration can ask for
+static const int MAX_PROCESSORS = 64;
+//a processor with work to spare gives one process to a processor this many quanta behind
+static const int BALANCE_QUANTA = 4;
 typedef chrono::high_resolution_clock Time;
 chrono::high_resolution_clock::time_point timeInit;
 //create the mutexes
 pthread_mutex_t mutexMEMORY;
 pthread_mutex_t mutexPROCESSID;
-pthread_mutex_t mutexHARDDRIVE;
-pthread_mutex_t mutexPRINTER;
-pthread_mutex_t mutexKEYBOARD;
-pthread_mutex_t mutexMONITOR;
-pthread_mutex_t mutexMOUSE;
 pthread_mutex_t mutexLOADER;
-pthread_mutex_t mutexRR;
+pthread_mutex_t mutexLOG = PTHREAD_MUTEX_INITIALIZER;
 //create the semaphores
 sem_t semHARDDRIVE;
 sem_t semPRINTER;
@@ -36,7 +42,101 @@ sem_t semKEYBOARD;
 sem_t semMONITOR;
 sem_t semMOUSE;
 sem_t semLOADER;
-sem_t semRR;
+//background I/O waiting on each device, an operation or loader the caller waits on runs on
+//the caller's thread since handing it to another thread only adds two wakeups
+static const int WORKER_QUEUE_SIZE = 64;
+//an input or output operation running in the background
+struct IORequest
+{
+	OperatingSystem *ptr;
+	Operation operation;
+	int processID;
+	vector<Operation> remaining; //rest of the process, scheduled again once the operation is done
+	ProcessControlBlock *block; //round robin keeps the rest of the process here instead
+};
+//one queue per device, made the first time the device is used in the background
+static WorkerPool *deviceWorkers[DEV_COUNT];
+//finished requests waiting to be scheduled again
+static vector<IORequest*> completedIO;
+static atomic<int> pendingIO(0);
+pthread_mutex_t mutexIO = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t condIO = PTHREAD_COND_INITIALIZER;
+//processors with nothing to run wait here until a process is queued
+pthread_mutex_t mutexIDLE = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t condIDLE = PTHREAD_COND_INITIALIZER;
+static atomic<int> idleProcessors(0);
+//processor the thread runs, NULL on threads that are not processors
+static thread_local Processor *currentProcessor = NULL;
+//operation handlers indexed by opcode
+typedef void (*OperationHandler)(OperatingSystem*, const chrono::high_resolution_clock::time_point, chrono::high_resolution_clock::time_point, double);
+static const OperationHandler operationHandlers[OP_CODE_COUNT] = {
+	OperatingSystem::startOP,
+	OperatingSystem::applicationOP,
+	OperatingSystem::processOP,
+	OperatingSystem::inputOP,
+	OperatingSystem::outputOP,
+	OperatingSystem::memoryOP
+};
+//everything needed to run an operation on a device
+struct DeviceInfo
+{
+	sem_t *semaphore;
+	int (Config::*cycleTime)() const;
+	const char *unit; //name printed with the resource number, NULL if not printed
+	bool input;
+	bool output;
+};
+//device information indexed by device
+static const DeviceInfo deviceTable[DEV_COUNT] = {
+	{NULL, NULL, NULL, false, false},                               //begin
+	{NULL, NULL, NULL, false, false},                               //finish
+	{NULL, &Config::getProcessorTime, NULL, false, false},          //run
+	{&semHARDDRIVE, &Config::getHarddriveTime, "HDD", true, true},  //hard drive
+	{&semKEYBOARD, &Config::getKeyboardTime, NULL, true, false},    //keyboard
+	{&semMOUSE, &Config::getMouseTime, NULL, true, false},          //mouse
+	{&semMONITOR, &Config::getMonitorTime, NULL, false, true},      //monitor
+	{&semPRINTER, &Config::getPrinterTime, "PRIN", false, true},    //printer
+	{NULL, &Config::getMemoryTime, NULL, false, false},             //block
+	{NULL, &Config::getMemoryTime, NULL, false, false}              //allocate
+};
+/**
+ * @name logLine
+ *
+ * @details prints one line to the monitor and/or the log file, the lock keeps lines from
+ *          different threads from being mixed together
+ * @param timeStamp
+ *      time printed at the start of the line
+ * @param text
+ *      rest of the line
+ */
+void OperatingSystem::logLine(double timeStamp, const string &text){
+	pthread_mutex_lock(&mutexLOG);
+	if (print == true)
+		cout << timeStamp << " - " << text << endl;
+	if (write == true)
+		file << timeStamp << " - " << text << endl;
+	pthread_mutex_unlock(&mutexLOG);
+}
+/**
+ * @name waitForWork
+ *
+ * @details lets a processor with nothing to run wait until a process is queued anywhere
+ * @param until
+ *      when to stop waiting if nothing is queued
+ */
+static void waitForWork(const chrono::high_resolution_clock::time_point until){
+	chrono::system_clock::time_point deadline = chrono::system_clock::now() + chrono::duration_cast<chrono::system_clock::duration>(until - Time::now());
+	chrono::nanoseconds sinceEpoch = chrono::duration_cast<chrono::nanoseconds>(deadline.time_since_epoch());
+	timespec wake;
+	wake.tv_sec = sinceEpoch.count() / 1000000000;
+	wake.tv_nsec = sinceEpoch.count() % 1000000000;
+
+	pthread_mutex_lock(&mutexIDLE);
+	idleProcessors++;
+	pthread_cond_timedwait(&condIDLE, &mutexIDLE, &wake);
+	idleProcessors--;
+	pthread_mutex_unlock(&mutexIDLE);
+}
 //constructor
 OperatingSystem::OperatingSystem(){
 
@@ -69,10 +169,9 @@ bool OperatingSystem::getTimerStatus() const {
  * @param process
  *      operating system object
  */
-void OperatingSystem::threadUsage(vector<string> metaVector, OperatingSystem &process){
+void OperatingSystem::threadUsage(const vector<Operation> &operations, OperatingSystem &process){
 	void *threadPtr;
-	const int tidTotal = (metaVector.size() / 3);
-	const int i = 0;
+	vector<Operation> metaVector = operations;
     //check if set to writing
 	if (process.configPtr->getLog() == "Log to Both" || process.configPtr->getLog() == "Log to File"){
 		file.open(process.configPtr->getLogFile(), ios::out | ios::binary);
@@ -85,13 +184,7 @@ void OperatingSystem::threadUsage(vector<string> metaVector, OperatingSystem &pr
     //initialize the mutexes
 	pthread_mutex_init(&mutexMEMORY, NULL);
 	pthread_mutex_init(&mutexPROCESSID, NULL);
-	pthread_mutex_init(&mutexHARDDRIVE, NULL);
-	pthread_mutex_init(&mutexPRINTER, NULL);
-	pthread_mutex_init(&mutexKEYBOARD, NULL);
-	pthread_mutex_init(&mutexMONITOR, NULL);
-	pthread_mutex_init(&mutexMOUSE, NULL);
 	pthread_mutex_init(&mutexLOADER, NULL);
-	pthread_mutex_init(&mutexRR, NULL);
     //initialize the semaphores
 	sem_init(&semHARDDRIVE, 0, process.configPtr->getHarddriveResources());
 	sem_init(&semPRINTER, 0, process.configPtr->getPrinterResources());
@@ -99,47 +192,55 @@ void OperatingSystem::threadUsage(vector<string> metaVector, OperatingSystem &pr
 	sem_init(&semMONITOR, 0, process.configPtr->getMonitorResources());
 	sem_init(&semMOUSE, 0, process.configPtr->getMouseResources());
 	sem_init(&semLOADER, 0, 1);
-	sem_init(&semRR, 0, 1);
-    //thread ids that are equal to the number of operations
-	pthread_t threadID[tidTotal];
-	pthread_attr_t attr;
-	pthread_attr_init(&attr);
 	threadPtr = &process;
-    // round robin scheduling
-	if (process.configPtr->getCPUSchedulingAlgorithm() == "RR"){
+	if (metaVector.size() < 2){
+	    cerr << "Error, metadata file has no operations" << endl;
+	    exit(0);
+	}
+    // round robin scheduling, MLFQ is round robin on several levels, CFS runs the process
+    // that has had the least processor time for its weight, SRTF the one with the least
+    // time left and EDF the one with the earliest deadline
+	process.policy = SchedulerPolicy::create(process.configPtr->getCPUSchedulingAlgorithm(), process.configPtr);
+	if (process.policy != NULL){
+		int processorCount = process.configPtr->getProcessorCount();
+		if (processorCount < 1 || processorCount > MAX_PROCESSORS){
+			cerr << "Error, processor count must be from 1 to " << MAX_PROCESSORS << endl;
+			exit(0);
+		}
+		if (process.configPtr->getBurstWeight() < 0 || process.configPtr->getBurstWeight() > 100){
+			cerr << "Error, burst prediction weight must be from 0 to 100" << endl;
+			exit(0);
+		}
         //creating time points
 		chrono::milliseconds ms(100);
-		chrono::milliseconds rrMS(process.configPtr->getCPUQuantumNumber());
 		chrono::time_point<chrono::high_resolution_clock> endTime;
-		chrono::time_point<chrono::high_resolution_clock> rrTime;
 		endTime = chrono::high_resolution_clock::now() + ms;
-		rrTime = chrono::high_resolution_clock::now() + rrMS;
 
         //store the start and finish codes
-		process.s1 = *(metaVector.begin());
-		process.s2 = *(metaVector.begin() + 1);
-		process.s3 = *(metaVector.begin() + 2);
-		process.s4 = *(metaVector.end() - 3);
-		process.s5 = *(metaVector.end() - 2);
-		process.s6 = *(metaVector.end() - 1);
-		//remove S{begin}0
-		metaVector.erase(metaVector.begin(), metaVector.begin() + 3);
-		//remove S{finish}0
-		metaVector.erase(metaVector.end() - 3, metaVector.end());
+		process.systemStart = metaVector.front();
+		process.systemEnd = metaVector.back();
+		//remove S{begin}0 and S{finish}0
+		metaVector.erase(metaVector.begin());
+		metaVector.pop_back();
         // change the vector after removing the S
-		process.metaDataPtr->setmetaVector(metaVector);
+		process.metaDataPtr->setOperations(metaVector);
 
 		if (loadCount == 0){
-			process.scheduleVector.push_back(process.s1);
-			process.scheduleVector.push_back(process.s2);
-			process.scheduleVector.push_back(process.s3);
-
-			for (unsigned int k = 0; k < metaVector.size(); k++){
-				process.scheduleVector.push_back(metaVector[k]);
-			}
+			//room for every process of every load, a process is never queued twice
+			int programProcesses = count_if(metaVector.begin(), metaVector.end(), [](const Operation &op){
+				return op.code == OP_APPLICATION && op.device == DEV_BEGIN;
+			});
+			process.current = process.systemStart;
+			runner(threadPtr);
+			startProcessors(process, processorCount, programProcesses * (LOAD_LIMIT + 1), process.policy->levels());
+			admitRR(&process, metaVector);
 		}
-        //while not empty run the system
-		while (!(process.scheduleVector.empty()) || process.endReached != true){
+		//this thread is the first processor and also loads programs and takes interrupts
+		Processor &cpu = process.processors.front();
+		currentProcessor = &cpu;
+        //while not empty run the system, pending I/O is checked first since a process whose
+        //I/O is done counts as runnable before it stops counting as pending
+		while (pendingIO > 0 || process.runnableBlocks > 0 || process.endReached != true){
 			if (chrono::high_resolution_clock::now() >= endTime && process.endReached == false){
 				sem_wait(&semLOADER);
                 // if 100ms is reached than call loader
@@ -147,115 +248,92 @@ void OperatingSystem::threadUsage(vector<string> metaVector, OperatingSystem &pr
 				endTime = chrono::high_resolution_clock::now() + ms;
 				sem_post(&semLOADER);
 			}
-            // call on the threads
-			while (chrono::high_resolution_clock::now() < rrTime && !(process.scheduleVector.empty())){
-				//create a thread depending on operation
-			    process.mCode = process.scheduleVector[i];
-				process.mDescriptor = process.scheduleVector[i + 1];
-				process.mCycle = process.scheduleVector[i + 2];
-				pthread_create(&(threadID[i]), &attr, runner, threadPtr);
-				pthread_join(threadID[i], NULL);
-                //remove operation from vector
-				reverse(process.scheduleVector.begin(), process.scheduleVector.end());
-				process.scheduleVector.pop_back();
-				process.scheduleVector.pop_back();
-				process.scheduleVector.pop_back();
-				reverse(process.scheduleVector.begin(), process.scheduleVector.end());
+			// put back processes whose I/O is done, wait for one if nothing else is left to run
+			resumeBlocked(process, process.runnableBlocks == 0 && process.endReached == true);
+			// anything the policy has due, like the MLFQ boost or the next job of an EDF process
+			process.policy->tick();
+			releaseJobs(process);
+			ProcessControlBlock *block = nextReady(cpu);
+			if (block == NULL){
+				block = stealReady(cpu, 1);
 			}
-            //interrupt due to quantum time
-			if (chrono::high_resolution_clock::now() >= rrTime){
-				sem_wait(&semRR);
-				chrono::high_resolution_clock::time_point tc;
-				double timeStamp = 0.000000;
-				tc = Time::now();
-				timeStamp = calculateTime(timeInit, tc);
-
-				if (print == true)
-					cout << timeStamp << " - " << "Process " << process.processID << ": interrupt processing action" << endl;
-				if (write == true)
-					file << timeStamp << " - " << "Process " << process.processID << ": interrupt processing action" << endl;
-                //interrupt thread
-				loaderRRInterrupt(&process);
-				rrTime = chrono::high_resolution_clock::now() + rrMS;
-				sem_post(&semRR);
+			if (block == NULL){
+				// nothing to run until the loader is due or another processor queues a process
+				if (process.endReached == false){
+					waitForWork(process.policy->nextRelease(endTime));
+				}else if (process.runnableBlocks > 0){
+					waitForWork(process.policy->nextRelease(chrono::high_resolution_clock::now() + chrono::milliseconds(process.configPtr->getCPUQuantumNumber())));
+				}
+				continue;
 			}
+			//the process at the front runs until its quantum is used, it blocks or it ends
+			runQuantum(cpu, block);
+			balanceLoad(cpu);
 		}
+		stopProcessors(process);
 
-		process.scheduleVector.push_back(process.s4);
-		process.scheduleVector.push_back(process.s5);
-		process.scheduleVector.push_back(process.s6);
-
-		process.mCode = process.scheduleVector[i];
-		process.mDescriptor = process.scheduleVector[i + 1];
-		process.mCycle = process.scheduleVector[i + 2];
-		pthread_create(&(threadID[i]), &attr, runner, threadPtr);
-		pthread_join(threadID[i], NULL);
-
-		reverse(process.scheduleVector.begin(), process.scheduleVector.end());
-		process.scheduleVector.pop_back();
-		process.scheduleVector.pop_back();
-		process.scheduleVector.pop_back();
-		reverse(process.scheduleVector.begin(), process.scheduleVector.end());
+		process.policy->report(process.processors, process.processBlocks);
+		if (process.processors.size() > 1){
+			reportProcessors(process);
+		}
 
+		process.current = process.systemEnd;
+		runner(threadPtr);
 	}
 	else if (process.configPtr->getCPUSchedulingAlgorithm() == "STR"){ //STR scheduling
+		if (process.configPtr->getProcessorCount() != 1){
+			cerr << "Error, STR only runs on one processor" << endl;
+			exit(0);
+		}
 		chrono::milliseconds ms(100);
 		chrono::time_point<chrono::high_resolution_clock> endTime;
 		endTime = chrono::high_resolution_clock::now() + ms;
         // store start and finish codes
-		process.s1 = *(metaVector.begin());
-		process.s2 = *(metaVector.begin() + 1);
-		process.s3 = *(metaVector.begin() + 2);
-		process.s4 = *(metaVector.end() - 3);
-		process.s5 = *(metaVector.end() - 2);
-		process.s6 = *(metaVector.end() - 1);
-        //remove s{begin}0
-		metaVector.erase(metaVector.begin(), metaVector.begin() + 3);
-        //remove S{finish}0
-		metaVector.erase(metaVector.end() - 3, metaVector.end());
+		process.systemStart = metaVector.front();
+		process.systemEnd = metaVector.back();
+        //remove s{begin}0 and S{finish}0
+		metaVector.erase(metaVector.begin());
+		metaVector.pop_back();
         //
-		process.metaDataPtr->setmetaVector(metaVector);
+		process.metaDataPtr->setOperations(metaVector);
 
 		if (loadCount == 0){
-			process.scheduleVector.push_back(process.s1);
-			process.scheduleVector.push_back(process.s2);
-			process.scheduleVector.push_back(process.s3);
-
-			for (unsigned int k = 0; k < metaVector.size(); k++){
-				process.scheduleVector.push_back(metaVector[k]);
-			}
+			process.scheduleVector.push_back(process.systemStart);
+			process.scheduleVector.insert(process.scheduleVector.end(), metaVector.begin(), metaVector.end());
 		}
         //while not empty run the program
-		while (!(process.scheduleVector.empty())){
-			if (process.scheduleVector.at(i) == "A" && process.scheduleVector.at(i + 1) == "finish" && process.scheduleVector.at(i + 2) == "0" && process.endReached == false){
+		// loads more programs when the process at the front is finishing
+		auto loadOnFinish = [&process](){
+			if (!(process.scheduleVector.empty()) && isApplication(process.scheduleVector.front(), DEV_FINISH, 0) && process.endReached == false){
 				sem_wait(&semLOADER);
 				chrono::high_resolution_clock::time_point tc;
 				double timeStamp = 0.000000;
 				tc = Time::now();
 				timeStamp = calculateTime(timeInit, tc);
 
-				if (print == true)
-					cout << timeStamp << " - " << "Process " << process.processID << ": interrupt processing action" << endl;
-				if (write == true)
-					file << timeStamp << " - " << "Process " << process.processID << ": interrupt processing action" << endl;
+				logLine(timeStamp, "Process " + to_string(process.processID) + ": interrupt processing action");
 
 				loaderSTR(&process);
 				sem_post(&semLOADER);
 			}
+		};
+		while (!(process.scheduleVector.empty()) || !(process.processTable.empty()) || pendingIO > 0){
+			// put back processes whose I/O is done, wait for one if nothing else is left to run
+			resumeBlocked(process, process.scheduleVector.empty() && process.processTable.empty());
+			nextProcessSTR(process);
+			loadOnFinish();
             // call on the threads
-			while (chrono::high_resolution_clock::now() < endTime && !(process.scheduleVector.empty())){
-                // create a thread depending on the operation
-				process.mCode = process.scheduleVector[i];
-				process.mDescriptor = process.scheduleVector[i + 1];
-				process.mCycle = process.scheduleVector[i + 2];
-				pthread_create(&(threadID[i]), &attr, runner, threadPtr);
-				pthread_join(threadID[i], NULL);
-                //remove operation from vector
-				reverse(process.scheduleVector.begin(), process.scheduleVector.end());
-				process.scheduleVector.pop_back();
-				process.scheduleVector.pop_back();
-				process.scheduleVector.pop_back();
-				reverse(process.scheduleVector.begin(), process.scheduleVector.end());
+			while (chrono::high_resolution_clock::now() < endTime && (!(process.scheduleVector.empty()) || !(process.processTable.empty()))){
+				nextProcessSTR(process);
+				// without blocking I/O the schedule can run dry before the time slice ends, so
+				// load at every process end instead of only the ones that fall on a slice. The
+				// last process finishing loads too or the simulator would end early
+				if (process.asyncIO || (process.scheduleVector.size() == 1 && process.processTable.empty())){
+					loadOnFinish();
+				}
+                // run the operation
+				dispatch(process);
+				resumeBlocked(process, false);
 			}
 			endTime = chrono::high_resolution_clock::now() + ms;
 		}
@@ -275,17 +353,10 @@ void OperatingSystem::threadUsage(vector<string> metaVector, OperatingSystem &pr
 	sem_destroy(&semMONITOR);
 	sem_destroy(&semMOUSE);
 	sem_destroy(&semLOADER);
-	sem_destroy(&semRR);
     //destroy the mutexes
 	pthread_mutex_destroy(&mutexMEMORY);
 	pthread_mutex_destroy(&mutexPROCESSID);
-	pthread_mutex_destroy(&mutexHARDDRIVE);
-	pthread_mutex_destroy(&mutexPRINTER);
-	pthread_mutex_destroy(&mutexKEYBOARD);
-	pthread_mutex_destroy(&mutexMONITOR);
-	pthread_mutex_destroy(&mutexMOUSE);
 	pthread_mutex_destroy(&mutexLOADER);
-	pthread_mutex_destroy(&mutexRR);
 }
 
 /**
@@ -325,7 +396,7 @@ void* OperatingSystem::runner(void *parameter){
     //run program for each thread
 	programInfo(opPtr, t0);
 
-	pthread_exit(0);
+	return NULL;
 }
 
 /**
@@ -340,47 +411,8 @@ void OperatingSystem::OperatingSystem::getDelay(OperatingSystem *ptr, int operat
     unsigned int delay;
     //calculate delay time
     delay = (operationTime * cycleTime);
-    // delay the thread
-    this_thread::sleep_for(chrono::milliseconds(delay));
-
-    timer(ptr, operationTime, cycleTime);
-}
-
-/**
- * @name timer
- *
- * @details caclulates the time for how long the program has run
- * @param ptr
- *      operating system pointer
- * @param operationTime
- *      operation time
- * @param cycleTime
- *      cycle time
- */
-void OperatingSystem::timer(OperatingSystem *ptr, const int operationTime, const int cycleTime){
-    unsigned int delay;
-    //caclulate delay
-    delay = (operationTime * cycleTime);
-    typedef chrono::high_resolution_clock Time;
-    //time of program
-    auto t0 = ptr->programStart;
-    //time of program plus operation
-    auto t1 = ptr->programStart + chrono::milliseconds(delay);
-    chrono::milliseconds ms;
-    bool timerExpired = false;
-    //calculate difference
-    auto difference = chrono::duration_cast<chrono::milliseconds>(t1 - t0);
-    // go until time reaches time+delay
-    while (t1 > t0){
-        //update time
-        t0 = Time::now();
-        //check every 100ms if the time is expired
-        if (difference.count() == ms.count() && t0 != t1){
-            timerExpired = false;
-        }else{
-            timerExpired = true;
-        }
-    }
+    // sleep on the shared timer until the operation is done
+    TimerService::instance().sleepFor(chrono::milliseconds(delay));
 }
 
 /**
@@ -471,22 +503,11 @@ void OperatingSystem::programInfo(OperatingSystem *ptr, const chrono::high_resol
 	cout << fixed << showpoint << setprecision(8);
 	file << fixed << showpoint << setprecision(8);
     //choose how to complete operation call
-	if (ptr->mCode == "S"){
-		startOP(ptr, timeInitial, tCurr, tStamp);
-	}else if (ptr->mCode == "A"){
-		applicationOP(ptr, timeInitial, tCurr, tStamp);
-	}else if (ptr->mCode == "P"){
-		processOP(ptr, timeInitial, tCurr, tStamp);
-	}else if (ptr->mCode == "I"){
-		inputOP(ptr, timeInitial, tCurr, tStamp);
-	}else if (ptr->mCode == "O"){
-		outputOP(ptr, timeInitial, tCurr, tStamp);
-	}else if (ptr->mCode == "M"){
-		memoryOP(ptr, timeInitial, tCurr, tStamp);
-	}else{
+	if (ptr->current.code >= OP_CODE_COUNT){
 	    cerr << "Error, invalid metadata code" << endl;
 	    exit(0);
 	}
+	operationHandlers[ptr->current.code](ptr, timeInitial, tCurr, tStamp);
 }
 
 /**
@@ -504,23 +525,17 @@ void OperatingSystem::startOP(OperatingSystem *ptr, const chrono::high_resolutio
 
 	typedef chrono::high_resolution_clock Time;
     //checks if it needs to write, print, or do both
-	if (ptr->mDescriptor == "begin" || ptr->mDescriptor == "start"){
+	if (ptr->current.device == DEV_BEGIN){
 		if (ptr->configPtr->getLog() == "Log to Both"){
 			ptr->processorState = "READY"; //change state
             timeFinal = Time::now(); //get final time
 			timeStamp = calculateTime(timeInitial, timeFinal); //calculate the difference
-			if (print == true)
-				cout << timeStamp << " - " << "Simulator program starting" << endl;
-			if (write == true)
-				file << timeStamp << " - " << "Simulator program starting" << endl;
+			logLine(timeStamp, "Simulator program starting");
 		}
 	}else{
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Simulator program ending" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Simulator program ending" << endl;
+		logLine(timeStamp, "Simulator program ending");
 		ptr->processorState = "EXIT";
 	}
 }
@@ -539,10 +554,10 @@ void OperatingSystem::applicationOP(OperatingSystem *ptr, const chrono::high_res
 
 	typedef chrono::high_resolution_clock Time;
 
-	if (ptr->mDescriptor == "begin" || ptr->mDescriptor == "start"){
+	if (ptr->current.device == DEV_BEGIN){
 		pthread_mutex_lock(&mutexPROCESSID); // lock the mutex
 
-		if (ptr->mCycle == "0"){
+		if (ptr->current.cycles == 0){
 			if (rrCall == true){
 				ptr->processID = ptr->rrID;
 			}
@@ -551,12 +566,12 @@ void OperatingSystem::applicationOP(OperatingSystem *ptr, const chrono::high_res
 			rrCall = false;
 		}
 
-		if (ptr->mCycle != "0"){
+		if (ptr->current.cycles != 0){
 			if (rrCall == false){
 				ptr->rrID = ptr->processID;
 			}
 
-			ptr->processID = stoi(ptr->mCycle);
+			ptr->processID = ptr->current.cycles;
 			rrCall = true;
 		}
 
@@ -565,26 +580,17 @@ void OperatingSystem::applicationOP(OperatingSystem *ptr, const chrono::high_res
 		ptr->processorState = "READY";
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal); //get current time
-		if (print == true)
-			cout << timeStamp << " - " << "OS: preparing process " << ptr->processID << "" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "OS: preparing process " << ptr->processID << "" << endl;
+		logLine(timeStamp, "OS: preparing process " + to_string(ptr->processID));
 
 		ptr->processorState = "RUNNING";
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal); //get current time
-		if (print == true)
-			cout << timeStamp << " - " << "OS: starting process " << ptr->processID << "" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "OS: starting process " << ptr->processID << "" << endl;
+		logLine(timeStamp, "OS: starting process " + to_string(ptr->processID));
 	}
 	else{
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal); //get current time
-		if (print == true)
-			cout << timeStamp << " - " << "OS: removing process " << ptr->processID << "" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "OS: removing process " << ptr->processID << "" << endl;
+		logLine(timeStamp, "OS: removing process " + to_string(ptr->processID));
 
 		ptr->resetMemory = true; //reset memory
 	}
@@ -605,25 +611,19 @@ void OperatingSystem::processOP(OperatingSystem *ptr, const chrono::high_resolut
 
 	typedef chrono::high_resolution_clock Time;
 
-	if (ptr->mDescriptor == "run"){
+	if (ptr->current.device == DEV_RUN){
 		ptr->processorState = "RUNNING"; //set state
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal); //get current time
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start processing action" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start processing action" << endl;
+		logLine(timeStamp, "Process " + to_string(ptr->processID) + ": start processing action");
 
 		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getProcessorTime(), stoi(ptr->mCycle)); //calculate delay
+		ptr->getDelay(ptr, ptr->configPtr->getProcessorTime(), ptr->current.cycles); //calculate delay
 		ptr->processorState = "READY";
 		ptr->processorState = "RUNNING";
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal);// get current time again
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end processing action" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end processing action" << endl;
+		logLine(timeStamp, "Process " + to_string(ptr->processID) + ": end processing action");
 	}
 }
 /**
@@ -636,94 +636,9 @@ void OperatingSystem::processOP(OperatingSystem *ptr, const chrono::high_resolut
  * @param timeStamp
  */
 void OperatingSystem::inputOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp){
-
-	cout << fixed << showpoint << setprecision(6);
-
-	typedef chrono::high_resolution_clock Time;
-	// if descriptor is hard drive
-	if (ptr->mDescriptor == "hard drive"){
-		sem_wait(&semHARDDRIVE);
-		pthread_mutex_lock(&mutexHARDDRIVE);
-
-		ptr->processorState = "RUNNING";
-        timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal); //get current time
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input on HDD " << ptr->resourceManager->harddrive.front() << endl;
-
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input on HDD " << ptr->resourceManager->harddrive.front() << endl;
-
-		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getHarddriveTime(), stoi(ptr->mCycle)); //delay time
-
-		ptr->processorState = "READY";
-		ptr->processorState = "RUNNING";
-        timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal); //get current time 
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " input" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input" << endl;
-		//update the resources for hard drive
-		ptr->resourceManager->resourceManagement(ptr->mDescriptor);
-		
-		pthread_mutex_unlock(&mutexHARDDRIVE);
-		sem_post(&semHARDDRIVE);
-	}else if (ptr->mDescriptor == "keyboard"){ // if descriptor is keyboard 
-
-		sem_wait(&semKEYBOARD);
-		pthread_mutex_lock(&mutexKEYBOARD);
-
-		ptr->processorState = "RUNNING";
-        timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input" << endl;
-
-		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getKeyboardTime(), stoi(ptr->mCycle));
-		ptr->processorState = "READY";
-		ptr->processorState = "RUNNING";
-        timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " input" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " input" << endl;
-		
-		ptr->resourceManager->resourceManagement(ptr->mDescriptor);
-		pthread_mutex_unlock(&mutexKEYBOARD);
-		sem_post(&semKEYBOARD);
-	}else if (ptr->mDescriptor == "mouse"){ //if descriptor is mouse
-		sem_wait(&semMOUSE);
-		pthread_mutex_lock(&mutexMOUSE);
-
-		ptr->processorState = "RUNNING";
-        timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " input" << endl;
-
-		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getMouseTime(), stoi(ptr->mCycle));
-		ptr->processorState = "READY";
-		ptr->processorState = "RUNNING";
-        timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " input" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " input" << endl;
-		
-		ptr->resourceManager->resourceManagement(ptr->mDescriptor);
-		pthread_mutex_unlock(&mutexMOUSE);
-		sem_post(&semMOUSE);
-	}
+	// only hard drive, keyboard, and mouse take input
+	if (deviceTable[ptr->current.device].input)
+		deviceOP(ptr, timeInitial, timeFinal, timeStamp, "input");
 }
 
 /**
@@ -736,91 +651,229 @@ void OperatingSystem::inputOP(OperatingSystem *ptr, const chrono::high_resolutio
  * @param timeStamp 
  */
 void OperatingSystem::outputOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp){
+	// only hard drive, monitor, and printer give output
+	if (deviceTable[ptr->current.device].output)
+		deviceOP(ptr, timeInitial, timeFinal, timeStamp, "output");
+}
+
+/**
+ * @name deviceOP
+ *
+ * @details runs an input or output operation on the device from the device table
+ * @param ptr
+ * @param timeInitial
+ * @param timeFinal
+ * @param timeStamp
+ * @param direction
+ *      input or output
+ */
+void OperatingSystem::deviceOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp, const char *direction){
+	ptr->processorState = "WAITING";
+	deviceIO(ptr, ptr->current, ptr->processID, timeInitial, direction);
+	ptr->processorState = "READY";
+	ptr->processorState = "RUNNING";
+}
+
+/**
+ * @name deviceIO
+ *
+ * @details waits for the device, prints the start and end of the operation on the instance it
+ *          took. Only uses what is passed in so it can run while another process runs
+ * @param ptr
+ * @param operation
+ *      input or output operation to run
+ * @param processID
+ *      process the operation belongs to
+ * @param timeInitial
+ * @param direction
+ *      input or output
+ */
+void OperatingSystem::deviceIO(OperatingSystem *ptr, const Operation &operation, int processID, const chrono::high_resolution_clock::time_point timeInitial, const char *direction){
 
 	cout << fixed << showpoint << setprecision(6);
 
 	typedef chrono::high_resolution_clock Time;
-    //if the descriptor is hard drive
-	if (ptr->mDescriptor == "hard drive"){
-		sem_wait(&semHARDDRIVE);
-		pthread_mutex_lock(&mutexHARDDRIVE);
+	const DeviceInfo &device = deviceTable[operation.device];
+	const char *descriptor = deviceName(operation.device);
+	double timeStamp;
 
-		ptr->processorState = "RUNNING";
-		timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " output on HDD " << ptr->resourceManager->harddrive.front() << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " output on HDD " << ptr->resourceManager->harddrive.front() << endl;
+	//the semaphore makes sure an instance is free before one is taken
+	sem_wait(device.semaphore);
+	int instance = ptr->resourceManager->acquire(operation.device);
 
-		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getHarddriveTime(), stoi(ptr->mCycle));
-		ptr->processorState = "READY";
-		ptr->processorState = "RUNNING";
-		timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " output" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " output" << endl;
-		
-		ptr->resourceManager->resourceManagement(ptr->mDescriptor);
-		pthread_mutex_unlock(&mutexHARDDRIVE);
-		sem_post(&semHARDDRIVE);
-	}else if (ptr->mDescriptor == "monitor"){ //if the descriptor is monitor
-		sem_wait(&semMONITOR);
-		pthread_mutex_lock(&mutexMONITOR);
-		
-		ptr->processorState = "RUNNING";
-		timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " output" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " output" << endl;
+	timeStamp = calculateTime(timeInitial, Time::now()); //get current time
+	if (device.unit != NULL){
+		logLine(timeStamp, "Process " + to_string(processID) + ": start " + descriptor + " " + direction + " on " + device.unit + " " + to_string(instance));
+	}else{
+		logLine(timeStamp, "Process " + to_string(processID) + ": start " + descriptor + " " + direction);
+	}
 
-		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getMonitorTime(), stoi(ptr->mCycle));
-		ptr->processorState = "READY";
-		ptr->processorState = "RUNNING";
-		timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " output" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " output" << endl;
-		
-		ptr->resourceManager->resourceManagement(ptr->mDescriptor);
-		pthread_mutex_unlock(&mutexMONITOR);
-		sem_post(&semMONITOR);
-	}else if (ptr->mDescriptor == "printer"){ //if descriptor is printer
-		sem_wait(&semPRINTER);
-		pthread_mutex_lock(&mutexPRINTER);
+	ptr->getDelay(ptr, (ptr->configPtr->*device.cycleTime)(), operation.cycles); //delay time
 
-		ptr->processorState = "RUNNING";
-		timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " output on PRIN " << ptr->resourceManager->printer.front() << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start " << ptr->mDescriptor << " output on PRIN " << ptr->resourceManager->printer.front() << endl;
+	timeStamp = calculateTime(timeInitial, Time::now()); //get current time
+	logLine(timeStamp, "Process " + to_string(processID) + ": end " + descriptor + " " + direction);
+	//give the instance back to the device
+	ptr->resourceManager->release(operation.device, instance);
+	sem_post(device.semaphore);
+}
 
-		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getPrinterTime(), stoi(ptr->mCycle));
+/**
+ * @name submitIO
+ *
+ * @details hands a request to the threads of its device
+ * @param request
+ * @param instances
+ *      how many of the device there are
+ */
+static void submitIO(IORequest *request, int instances){
+	pthread_mutex_lock(&mutexIO);
+	if (deviceWorkers[request->operation.device] == NULL){
+		//one thread per instance so every instance of the device can be busy at once
+		deviceWorkers[request->operation.device] = new WorkerPool(max(1, instances), WORKER_QUEUE_SIZE);
+	}
+	pendingIO++;
+	pthread_mutex_unlock(&mutexIO);
+	deviceWorkers[request->operation.device]->submit(OperatingSystem::runnerIO, request);
+}
 
-		ptr->processorState = "READY";
-		ptr->processorState = "RUNNING";
-		timeFinal = Time::now();
-		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " output" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end " << ptr->mDescriptor << " output" << endl;
-		
-		ptr->resourceManager->resourceManagement(ptr->mDescriptor);
-		pthread_mutex_unlock(&mutexPRINTER);
-		sem_post(&semPRINTER);
+/**
+ * @name dispatch
+ *
+ * @details runs the operation at the front of the schedule. With asynchronous I/O an input or
+ *          output operation is handed to its device instead and the process is blocked
+ * @param process
+ * @return
+ *      true if the process was blocked and the processor is free for the next one
+ */
+bool OperatingSystem::dispatch(OperatingSystem &process){
+	const Operation &front = process.scheduleVector.front();
+	if (process.asyncIO){
+		// the simulator only ends once every blocked process has finished
+		if (front.code == OP_START && front.device == DEV_FINISH && pendingIO > 0){
+			resumeBlocked(process, true);
+			return false;
+		}
+		const DeviceInfo &device = deviceTable[front.device];
+		if ((front.code == OP_INPUT && device.input) || (front.code == OP_OUTPUT && device.output)){
+			process.current = front;
+			startIO(process);
+			return true;
+		}
+	}
+	process.current = front;
+	runner(&process);
+	//remove operation from vector
+	process.scheduleVector.erase(process.scheduleVector.begin());
+	return false;
+}
+
+/**
+ * @name startIO
+ *
+ * @details takes the rest of the running process off the schedule and queues the operation on
+ *          its device, the process is put back when the device is done
+ * @param process
+ */
+void OperatingSystem::startIO(OperatingSystem &process){
+	IORequest *request = new IORequest;
+	request->ptr = &process;
+	request->operation = process.current;
+	request->processID = process.processID;
+	//everything up to the next process or the end of the simulator belongs to this process
+	auto next = process.scheduleVector.begin() + 1;
+	while (next != process.scheduleVector.end() && !(next->code == OP_APPLICATION && next->device == DEV_BEGIN) && next->code != OP_START){
+		next++;
+	}
+	request->remaining.assign(process.scheduleVector.begin() + 1, next);
+	request->block = NULL;
+	process.scheduleVector.erase(process.scheduleVector.begin(), next);
+	submitIO(request, process.resourceManager->instanceCount(request->operation.device));
+}
+
+/**
+ * @name startIO
+ *
+ * @details queues the operation of a round robin process on its device, the process keeps its
+ *          place in its operations and goes back on the ready queue when the device is done
+ * @param process
+ * @param block
+ *      the blocked process, its program counter already past the operation
+ */
+void OperatingSystem::startIO(OperatingSystem &process, ProcessControlBlock *block){
+	IORequest *request = new IORequest;
+	request->ptr = &process;
+	request->operation = process.current;
+	request->processID = block->id;
+	request->block = block;
+	submitIO(request, process.resourceManager->instanceCount(request->operation.device));
+}
+
+/**
+ * @name runnerIO
+ *
+ * @details runs a background operation on its device thread and reports it as done
+ * @param parameter
+ *      the request
+ * @return
+ */
+void* OperatingSystem::runnerIO(void *parameter){
+	IORequest *request = static_cast<IORequest*>(parameter);
+	const char *direction = request->operation.code == OP_INPUT ? "input" : "output";
+	deviceIO(request->ptr, request->operation, request->processID, timeInit, direction);
+
+	pthread_mutex_lock(&mutexIO);
+	completedIO.push_back(request);
+	pthread_cond_signal(&condIO);
+	pthread_mutex_unlock(&mutexIO);
+	return NULL;
+}
+
+/**
+ * @name resumeBlocked
+ *
+ * @details handles the interrupt for every finished background operation and puts its
+ *          process back on the ready queue, or in the process table under STR
+ * @param process
+ * @param wait
+ *      wait for an operation to finish if none have and some are still running
+ * @return
+ *      true if any process was put back
+ */
+bool OperatingSystem::resumeBlocked(OperatingSystem &process, bool wait){
+	vector<IORequest*> finished;
+	pthread_mutex_lock(&mutexIO);
+	while (wait && completedIO.empty() && pendingIO > 0){
+		pthread_cond_wait(&condIO, &mutexIO);
+	}
+	finished.swap(completedIO);
+	//counted as runnable before they stop being pending so the simulator never sees neither
+	for (IORequest *request : finished){
+		if (request->block != NULL){
+			process.runnableBlocks++;
+		}
+	}
+	pendingIO -= finished.size();
+	//another processor may be waiting for the operations this one took
+	if (!(finished.empty())){
+		pthread_cond_broadcast(&condIO);
 	}
+	pthread_mutex_unlock(&mutexIO);
+
+	for (IORequest *request : finished){
+		logLine(calculateTime(timeInit, Time::now()), "Process " + to_string(request->processID) + ": interrupt processing action");
+		if (request->block != NULL){
+			//round robin puts the process at the back of the ready queue it last ran from
+			readyProcess(process.processors[request->block->processor], request->block);
+		}else{
+			//under STR the process picks up with its own id and waits its turn with the others
+			vector<Operation> resumed;
+			resumed.push_back(makeOperation(OP_APPLICATION, DEV_BEGIN, request->processID));
+			resumed.insert(resumed.end(), request->remaining.begin(), request->remaining.end());
+			process.processTable.add(resumed);
+		}
+		delete request;
+	}
+	return !finished.empty();
 }
 
 /**
@@ -840,38 +893,29 @@ void OperatingSystem::memoryOP(OperatingSystem *ptr, const chrono::high_resoluti
 
 	unsigned int memoryValue;
     //if the descriptor is block
-	if (ptr->mDescriptor == "block"){
+	if (ptr->current.device == DEV_BLOCK){
 		ptr->processorState = "RUNNING";
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": start memory " << ptr->mDescriptor << "ing" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": start memory " << ptr->mDescriptor << "ing" << endl;
+		logLine(timeStamp, "Process " + to_string(ptr->processID) + ": start memory " + deviceName(ptr->current.device) + "ing");
 
 		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getMemoryTime(), stoi(ptr->mCycle));
+		ptr->getDelay(ptr, ptr->configPtr->getMemoryTime(), ptr->current.cycles);
 
 		ptr->processorState = "READY";
 		ptr->processorState = "RUNNING";
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": end memory " << ptr->mDescriptor << "ing" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": end memory " << ptr->mDescriptor << "ing" << endl;
+		logLine(timeStamp, "Process " + to_string(ptr->processID) + ": end memory " + deviceName(ptr->current.device) + "ing");
 	}
-	else if (ptr->mDescriptor == "allocate"){ //if the descriptor is allocate
+	else if (ptr->current.device == DEV_ALLOCATE){ //if the descriptor is allocate
 		ptr->processorState = "RUNNING";
         timeFinal = Time::now();
 		timeStamp = calculateTime(timeInitial, timeFinal);
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": allocating memory" << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": allocating memory" << endl;
+		logLine(timeStamp, "Process " + to_string(ptr->processID) + ": allocating memory");
 
 		ptr->processorState = "WAITING";
-		ptr->getDelay(ptr, ptr->configPtr->getMemoryTime(), stoi(ptr->mCycle));
+		ptr->getDelay(ptr, ptr->configPtr->getMemoryTime(), ptr->current.cycles);
 		ptr->processorState = "READY";
 		ptr->processorState = "RUNNING";
         timeFinal = Time::now();
@@ -883,13 +927,9 @@ void OperatingSystem::memoryOP(OperatingSystem *ptr, const chrono::high_resoluti
 
 		pthread_mutex_unlock(&mutexMEMORY);
 
-		if (print == true)
-			cout << timeStamp << " - " << "Process " << ptr->processID << ": memory allocated at 0x" << setfill('0') << setw(8) << hex << memoryValue << endl;
-		if (write == true)
-			file << timeStamp << " - " << "Process " << ptr->processID << ": memory allocated at 0x" << setfill('0') << setw(8) << hex << memoryValue << endl;
-
-		cout << dec; //print out in decimal
-		file << dec; //print out in decimal
+		ostringstream address;
+		address << setfill('0') << setw(8) << hex << memoryValue;
+		logLine(timeStamp, "Process " + to_string(ptr->processID) + ": memory allocated at 0x" + address.str());
 	}
 }
 /**
@@ -902,8 +942,8 @@ void OperatingSystem::memoryOP(OperatingSystem *ptr, const chrono::high_resoluti
 void* OperatingSystem::runnerSTR(void *parameter){
     OperatingSystem *opPtr = static_cast<OperatingSystem*>(parameter);
     // call on the scheduler for STR
-    scheduleSTR(opPtr->metaDataPtr->getmetaVector(), opPtr);
-    pthread_exit(0);
+    scheduleSTR(opPtr->metaDataPtr->getOperations(), opPtr);
+    return NULL;
 }
 
 /**
@@ -914,94 +954,23 @@ void* OperatingSystem::runnerSTR(void *parameter){
  */
 void OperatingSystem::loaderSTR(OperatingSystem *ptr){
     void *threadPtr;
-    pthread_t threadID;
-    pthread_attr_t attr;
-    pthread_attr_init(&attr);
     threadPtr = ptr;
-    pthread_create(&threadID, &attr, ptr->runnerSTR, threadPtr);
-    pthread_join(threadID, NULL);
+    runnerSTR(threadPtr);
 }
 
 /**
- * @name scheduleSIOF
+ * @name nextProcessSTR
  *
- * @details calculates the number of IO process for a thread
- * @param threadVector
- * @param ptr
+ * @details starts the next process from the process table once the running one is done
+ * @param process
  */
-void OperatingSystem::scheduleSIOF(vector<string> threadVector, OperatingSystem *ptr){
-
-    int startPos, tempStartPos, tempEndPos, endPos;
-    vector<string>temp;
-    bool startCount = false;
-    bool stopCount = true;
-    bool finalCount;
-    int count = 0, previousCount = threadVector.size();
-    unsigned int i = 0;
-
-    temp.push_back(*(threadVector.begin()));
-    temp.push_back(*(threadVector.begin() + 1));
-    temp.push_back(*(threadVector.begin() + 2));
-    //run until the end of the vector
-    while (i < threadVector.size()){
-        //if the beginning is found than start the count
-        if (threadVector.at(i) == "A" && threadVector.at(i + 1) == "begin" && threadVector.at(i + 2) == "0"){
-            startCount = true;
-            stopCount = false;
-            tempStartPos = i;
-        }else if (startCount == true && stopCount == false && threadVector.at(i) == "A" && threadVector.at(i + 1) == "finish" && threadVector.at(i + 2) == "0"){
-            //if the end in reached then stop and determine which one has the lowest IO count
-            startCount = false;
-            stopCount = true;
-            tempEndPos = i + 2;
-
-            count += std::count(threadVector.begin() + tempStartPos, threadVector.begin() + tempEndPos, "I");
-            count += std::count(threadVector.begin() + tempStartPos, threadVector.begin() + tempEndPos, "O");
-
-            if (count != 0 && count < previousCount && count != previousCount){
-                startPos = tempStartPos;
-                endPos = tempEndPos;
-                previousCount = count;
-                count = 0;
-            }
-        }
-        i++;
-        //store vector based on priority and erase from original
-        if (i == threadVector.size() && stopCount == true){
-            if ( (find(threadVector.begin(), threadVector.end(), "I") != threadVector.end()) || (find(threadVector.begin(), threadVector.end(), "O") != threadVector.end()) ){
-                finalCount = false;
-            }
-            else{
-                finalCount = true;
-            }
-            if (finalCount == false){
-                for (int k = startPos; k <= endPos; k++){
-                    temp.push_back(threadVector[k]);
-                }
-
-                threadVector.erase( (threadVector.begin() + startPos), (threadVector.begin() + endPos + 1) );
-
-                i = 0;
-                count = 0;
-                previousCount = threadVector.size();
-            }
-        }
-    }
-    // add non IO tasks to end of vector
-    if (finalCount == true){
-        if (!(threadVector.empty())){
-            for (unsigned int k = 0; k < threadVector.size(); k++){
-                if (threadVector.at(k) == "A" && threadVector.at(k + 1) == "begin" && threadVector.at(k + 2) == "0"){
-                    startCount = true;
-                }
-                if (startCount == true){
-                    temp.push_back(threadVector[k]);
-                }
-            }
-        }
-    }
-
-    ptr->scheduleVector = temp;
+void OperatingSystem::nextProcessSTR(OperatingSystem &process){
+	const vector<Operation> &schedule = process.scheduleVector;
+	//only the end of the simulator is left, it waits until every process has run
+	bool idle = schedule.empty() || (schedule.front().code == OP_START && schedule.front().device == DEV_FINISH);
+	if (idle && !(process.processTable.empty())){
+		process.processTable.next(process.scheduleVector);
+	}
 }
 
 /**
@@ -1011,22 +980,24 @@ void OperatingSystem::scheduleSIOF(vector<string> threadVector, OperatingSystem
  * @param threadVector
  * @param ptr
  */
-void OperatingSystem::scheduleSTR(vector<string> threadVector, OperatingSystem *ptr){
+void OperatingSystem::scheduleSTR(const vector<Operation> &threadVector, OperatingSystem *ptr){
 
     pthread_mutex_lock(&mutexLOADER);
-    //load new processes to metadata vector
-    for (unsigned int j = 0; j < ptr->metaDataPtr->getmetaVector().size(); j++){
-        ptr->scheduleVector.push_back(ptr->metaDataPtr->getmetaVector()[j]);
+    //processes still waiting in the schedule go into the process table with the new ones
+    if (!(ptr->scheduleVector.empty())){
+        auto waiting = find_if(ptr->scheduleVector.begin() + 1, ptr->scheduleVector.end(), [](const Operation &op){
+            return op.code == OP_APPLICATION && op.device == DEV_BEGIN;
+        });
+        ptr->processTable.add(vector<Operation>(waiting, ptr->scheduleVector.end()));
+        ptr->scheduleVector.erase(waiting, ptr->scheduleVector.end());
     }
-    //call upon the IO scheduler
-    scheduleSIOF(ptr->scheduleVector, ptr);
+    //load new processes to the process table
+    ptr->processTable.add(threadVector);
     //increment load count
     loadCount++;
-    // if load count is 5, end the program
-    if (loadCount == 4 && ptr->endReached == false){
-        ptr->scheduleVector.push_back(ptr->s4);
-        ptr->scheduleVector.push_back(ptr->s5);
-        ptr->scheduleVector.push_back(ptr->s6);
+    // once every load is done, end the program
+    if (loadCount == LOAD_LIMIT && ptr->endReached == false){
+        ptr->scheduleVector.push_back(ptr->systemEnd);
         ptr->endReached = true;
     }
     pthread_mutex_unlock(&mutexLOADER);
@@ -1042,8 +1013,8 @@ void OperatingSystem::scheduleSTR(vector<string> threadVector, OperatingSystem *
 void* OperatingSystem::runnerRR(void *parameter){
     OperatingSystem *opPtr = static_cast<OperatingSystem*>(parameter);
     //use scheduler function for RR
-    scheduleRR(opPtr->metaDataPtr->getmetaVector(), opPtr);
-    pthread_exit(0);
+    scheduleRR(opPtr->metaDataPtr->getOperations(), opPtr);
+    return NULL;
 }
 
 /**
@@ -1054,12 +1025,8 @@ void* OperatingSystem::runnerRR(void *parameter){
  */
 void OperatingSystem::loaderRR(OperatingSystem *ptr){
     void *threadPtr;
-    pthread_t threadID;
-    pthread_attr_t attr;
-    pthread_attr_init(&attr);
     threadPtr = ptr;
-    pthread_create(&threadID, &attr, ptr->runnerRR, threadPtr);
-    pthread_join(threadID, NULL);
+    runnerRR(threadPtr);
 }
 
 /**
@@ -1069,187 +1036,453 @@ void OperatingSystem::loaderRR(OperatingSystem *ptr){
  * @param threadVector
  * @param ptr
  */
-void OperatingSystem::scheduleRR(vector<string> threadVector, OperatingSystem *ptr){
+void OperatingSystem::scheduleRR(const vector<Operation> &threadVector, OperatingSystem *ptr){
 	pthread_mutex_lock(&mutexLOADER);
-	//load processes into vector
-	for (unsigned int j = 0; j < ptr->metaDataPtr->getmetaVector().size(); j++){
-		ptr->scheduleVector.push_back(ptr->metaDataPtr->getmetaVector()[j]);
-	}
+	//load processes into the ready queue
+	admitRR(ptr, threadVector);
     //increase load count
 	loadCount++;
-	//if load count is 5 then end
-	if (loadCount == 4 && ptr->endReached == false){
+	//once every load is done, end
+	if (loadCount == LOAD_LIMIT && ptr->endReached == false){
 		ptr->endReached = true;
 	}
 	pthread_mutex_unlock(&mutexLOADER);
 }
 
 /**
- * @name scheduleRRInterrupt
+ * @name admitRR
  *
- * @detials scheduler for when RR is interrupted
- * @param threadVector
+ * @details makes a process control block for every process and queues them in order
  * @param ptr
+ * @param operations
  */
-void OperatingSystem::scheduleRRInterrupt(vector<string> threadVector, OperatingSystem *ptr){
-
-	pthread_mutex_lock(&mutexRR);
-    //if the vector is not empty or has not been read 5 times
-	if ( !(ptr->scheduleVector.empty()) || ptr->endReached != true ){
-		vector<string>temp;
-		int count = 0;
-		string currentprocessID;
-		int quantity = 0;
-		temp.push_back("A");
-		temp.push_back("begin");
-		temp.push_back(to_string(ptr->processID));
-        // if operation was I than calculate new run time
-		if (ptr->mCode == "I"){
-			if (ptr->mDescriptor == "hard drive"){
-				quantity = ((ptr->configPtr->getHarddriveTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getHarddriveTime()));
-
-				quantity = (((ptr->configPtr->getHarddriveTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getHarddriveTime()));
-
-				if (quantity > 0){
-					temp.push_back("I");
-					temp.push_back("hard drive");
-					temp.push_back(to_string(quantity));
-				}
-			}else if (ptr->mDescriptor == "keyboard"){
-				quantity = ( (ptr->configPtr->getKeyboardTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getKeyboardTime()) );
-
-				quantity = ( ((ptr->configPtr->getKeyboardTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber()) ) / (ptr->configPtr->getKeyboardTime()) );
-
-				if (quantity > 0){
-					temp.push_back("I");
-					temp.push_back("keyboard");
-					temp.push_back(to_string(quantity));
-				}
-			}else if (ptr->mDescriptor == "mouse"){
-				quantity = ((ptr->configPtr->getMouseTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getMouseTime()));
-
-				quantity = (((ptr->configPtr->getMouseTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getMouseTime()));
+void OperatingSystem::admitRR(OperatingSystem *ptr, const vector<Operation> &operations){
+	ProcessControlBlock *block = NULL;
+	size_t first = ptr->processBlocks.size();
+	for (const Operation &op : operations){
+		if (op.code == OP_APPLICATION && op.device == DEV_BEGIN){
+			ptr->processBlocks.push_back(ProcessControlBlock());
+			block = &ptr->processBlocks.back();
+			block->id = 0;
+			block->programCounter = 0;
+			block->remaining = chrono::nanoseconds(0);
+			block->order = ptr->processBlocks.size();
+			//the id is handed out when it first runs
+			block->cpuTime = chrono::nanoseconds(0);
+			block->nextQueued = NULL;
+			block->work = chrono::nanoseconds(0);
+			block->burst = chrono::nanoseconds(0);
+			//what the policy keeps for the process, like its weight or its deadline
+			ptr->policy->admit(block, op, op.timing != 0 ? &ptr->metaDataPtr->getTiming(op.timing) : NULL);
+			block->operations.push_back(makeOperation(OP_APPLICATION, DEV_BEGIN, 0));
+		}else if (block != NULL){
+			block->operations.push_back(op);
+			block->work += operationTime(*ptr, op);
+		}
+	}
+	if (!(ptr->policy->admitSet(ptr->processBlocks, first, ptr->processors.size()))){
+		ptr->processBlocks.erase(ptr->processBlocks.begin() + first, ptr->processBlocks.end());
+		return;
+	}
+	//other processors can take a process as soon as it is queued, so it has to be whole
+	for (size_t i = first; i < ptr->processBlocks.size(); i++){
+		ptr->runnableBlocks++;
+		readyProcess(leastLoaded(*ptr), &ptr->processBlocks[i]);
+	}
+}
 
-				if (quantity > 0){
-					temp.push_back("I");
-					temp.push_back("mouse");
-					temp.push_back(to_string(quantity));
-				}
+/**
+ * @name runQuantum
+ *
+ * @details runs a process from where it stopped until its quantum is used, it blocks on
+ *          I/O or it ends. A process that still has work left goes to the back of the queue,
+ *          under MLFQ one level down since it used its whole quantum. Only the processing actions
+ *          count as processor time, what the process waited on devices and memory is left out
+ *          of its virtual runtime, its processor time and how busy the processor was. Under
+ *          SRTF and EDF a process that still goes first keeps the processor without an interrupt
+ * @param cpu
+ *      the processor it runs on
+ * @param block
+ *      the process to run
+ */
+void OperatingSystem::runQuantum(Processor &cpu, ProcessControlBlock *block){
+	OperatingSystem &process = *cpu.system;
+	OperatingSystem &core = *cpu.core;
+	int levelIndex = process.policy->level(block);
+	ReadyLevel &level = cpu.readyLevels[levelIndex];
+	chrono::high_resolution_clock::time_point quantumStart, quantumEnd;
+	chrono::nanoseconds ran(0); //processor time, the slices of processing actions
+	bool blocked = false;
+	bool kept = block == cpu.kept;
+	cpu.kept = NULL;
+	//every level down doubles the quantum
+	quantumStart = Time::now();
+	quantumEnd = quantumStart + chrono::milliseconds(process.configPtr->getCPUQuantumNumber() << levelIndex);
+	level.quanta++;
+	block->processor = cpu.id;
+	//a process gets the next id when it first starts, the runner only sees ids so processors
+	//do not hand out the same one
+	if (block->programCounter == 0){
+		block->id = ++process.startedProcesses;
+		block->programCounter++;
+	}
+	if (!kept){
+		core.current = makeOperation(OP_APPLICATION, DEV_BEGIN, block->id);
+		runner(cpu.core);
+	}
+	process.policy->startQuantum(cpu, block, quantumStart);
+	while (block->programCounter < block->operations.size()){
+		const Operation &op = block->operations[block->programCounter];
+		//removing a process takes no time, everything else waits for the next quantum
+		if (op.code != OP_APPLICATION && Time::now() >= quantumEnd){
+			break;
+		}
+		process.policy->startOperation(block, op);
+		core.current = op;
+		if (op.code == OP_PROCESS && op.device == DEV_RUN){
+			if (!runBurst(cpu, block, quantumEnd, ran)){
+				break;
 			}
-		}else if (ptr->mCode == "O"){ //if operation was O, calculate new run time
-			if (ptr->mDescriptor == "hard drive"){
-				quantity = ((ptr->configPtr->getHarddriveTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getHarddriveTime()));
-
-				quantity = (((ptr->configPtr->getHarddriveTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getHarddriveTime()));
-
-				if (quantity > 0){
-					temp.push_back("O");
-					temp.push_back("hard drive");
-					temp.push_back(to_string(quantity));
-				}
-			}else if (ptr->mDescriptor == "monitor"){
-				quantity = ((ptr->configPtr->getMonitorTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getMonitorTime()));
+		}else if (process.asyncIO && ((op.code == OP_INPUT && deviceTable[op.device].input) || (op.code == OP_OUTPUT && deviceTable[op.device].output))){
+			block->work -= operationTime(process, op);
+			block->programCounter++;
+			startIO(core, block);
+			blocked = true;
+			break;
+		}else{
+			runner(cpu.core);
+		}
+		block->work -= operationTime(process, op);
+		block->programCounter++;
+	}
+	level.used += chrono::duration_cast<chrono::nanoseconds>(Time::now() - quantumStart);
+	cpu.busy += ran;
+	block->cpuTime += ran;
+	bool done = blocked || block->programCounter == block->operations.size();
+	//under SRTF and EDF a process that still goes first runs on
+	if (process.policy->endQuantum(cpu, block, ran, done)){
+		return;
+	}
+	if (done){
+		//under EDF a process with a period comes back for its next job, it stays runnable
+		if (!blocked && process.policy->finish(block)){
+			return;
+		}
+		//started I/O is already pending so the simulator does not end in between
+		process.runnableBlocks--;
+		return;
+	}
+	//interrupt due to quantum time, under SRTF and EDF due to a process that goes first
+	logLine(calculateTime(timeInit, Time::now()), "Process " + to_string(block->id) + ": interrupt processing action");
+	readyProcess(cpu, block);
+}
 
-				quantity = (((ptr->configPtr->getMonitorTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getMonitorTime()));
+/**
+ * @name readyProcess
+ *
+ * @details puts a process at the back of the queue for its level, under CFS, STRIDE, SRTF
+ *          and EDF into the tree and under LOTTERY its tickets into the lottery. A process that
+ *          is new or was blocked starts at the lowest virtual runtime so far, otherwise it
+ *          would hold the processor until it caught up. Under SRTF and EDF it preempts the
+ *          running process if it has less time left or an earlier deadline. Only the
+ *          processor adds to its own levels, any other thread leaves the process in its inbox
+ * @param cpu
+ *      processor whose queue it goes on
+ * @param block
+ */
+void OperatingSystem::readyProcess(Processor &cpu, ProcessControlBlock *block){
+	block->processor = cpu.id;
+	cpu.system->policy->enqueue(cpu, block, &cpu == currentProcessor);
+	cpu.queued++;
+	//an idle processor takes it if this one is busy
+	if (idleProcessors > 0){
+		pthread_mutex_lock(&mutexIDLE);
+		pthread_cond_signal(&condIDLE);
+		pthread_mutex_unlock(&mutexIDLE);
+	}
+}
 
-				if (quantity > 0){
-					temp.push_back("O");
-					temp.push_back("monitor");
-					temp.push_back(to_string(quantity));
-				}
-			}else if (ptr->mDescriptor == "printer"){
-				quantity = ((ptr->configPtr->getPrinterTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getPrinterTime()));
+/**
+ * @name nextReady
+ *
+ * @details takes the process at the front of the highest level that has one, under CFS,
+ *          STRIDE, SRTF and EDF the leftmost process in the tree and under LOTTERY the one
+ *          holding a ticket drawn at random. Under SRTF and EDF the processor
+ *          itself gets back the process it kept unless one that goes first is queued, then the
+ *          kept one is interrupted. Under RR and MLFQ only the processor itself calls this, it
+ *          also moves its inbox to its levels and does a boost that is due
+ * @param cpu
+ * @return
+ *      NULL if no process is ready
+ */
+ProcessControlBlock *OperatingSystem::nextReady(Processor &cpu){
+	return cpu.system->policy->pick(cpu, &cpu == currentProcessor);
+}
 
-				quantity = (((ptr->configPtr->getPrinterTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getPrinterTime()));
+/**
+ * @name startProcessors
+ *
+ * @details makes the processors and starts a thread for every one after the first
+ * @param process
+ * @param count
+ *      how many processors
+ * @param capacity
+ *      most processes a ready queue level holds
+ * @param levels
+ *      levels of every ready queue
+ */
+void OperatingSystem::startProcessors(OperatingSystem &process, int count, size_t capacity, int levels){
+	for (int i = 0; i < count; i++){
+		process.processors.emplace_back();
+		Processor &cpu = process.processors.back();
+		cpu.id = i;
+		cpu.system = &process;
+		//the first processor runs on the operating system so one processor runs as it always has
+		cpu.core = i == 0 ? &process : new OperatingSystem(process.configPtr, process.metaDataPtr, process.resourceManager);
+		pthread_mutex_init(&cpu.lock, NULL);
+		for (int j = 0; j < levels; j++){
+			cpu.readyLevels.emplace_back();
+			ReadyLevel &level = cpu.readyLevels.back();
+			level.ready.setCapacity(capacity);
+			level.quanta = 0;
+			level.demotions = 0;
+			level.used = chrono::nanoseconds(0);
+		}
+		cpu.inbox = NULL;
+		cpu.boostEpoch = 0;
+		cpu.queued = 0;
+		cpu.minVruntime = chrono::nanoseconds(0);
+		cpu.fairClock = 0;
+		cpu.fairWeight = 0;
+		cpu.quanta = 0;
+		cpu.busy = chrono::nanoseconds(0);
+		cpu.steals = 0;
+		cpu.kept = NULL;
+		cpu.running = NULL;
+		cpu.runningKey = chrono::nanoseconds(0);
+		cpu.runningSince = Time::now();
+		cpu.preempt = false;
+		pthread_cond_init(&cpu.wakeup, NULL);
+		process.policy->addProcessor(cpu, capacity);
+	}
+	//the threads look at every processor so they start once all of them exist
+	for (size_t i = 1; i < process.processors.size(); i++){
+		pthread_create(&process.processors[i].thread, NULL, runnerProcessor, &process.processors[i]);
+	}
+}
 
-				if (quantity > 0){
-					temp.push_back("O");
-					temp.push_back("printer");
-					temp.push_back(to_string(quantity));
-				}
-			}
-		}else if (ptr->mCode == "M"){ //if operation was M, calculate new run time
-			if (ptr->mDescriptor == "allocate"){
-				quantity = ((ptr->configPtr->getMemoryTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getMemoryTime()));
+/**
+ * @name stopProcessors
+ *
+ * @details stops the processor threads once every process is done
+ * @param process
+ */
+void OperatingSystem::stopProcessors(OperatingSystem &process){
+	process.shutdown = true;
+	pthread_mutex_lock(&mutexIDLE);
+	pthread_cond_broadcast(&condIDLE);
+	pthread_mutex_unlock(&mutexIDLE);
+	for (size_t i = 1; i < process.processors.size(); i++){
+		pthread_join(process.processors[i].thread, NULL);
+		delete process.processors[i].core;
+	}
+	for (Processor &cpu : process.processors){
+		pthread_mutex_destroy(&cpu.lock);
+		pthread_cond_destroy(&cpu.wakeup);
+	}
+}
 
-				quantity = (((ptr->configPtr->getMemoryTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getMemoryTime()));
+/**
+ * @name runnerProcessor
+ *
+ * @details thread of every processor after the first, runs processes from its own queue and
+ *          takes one from the busiest processor when its queue is empty
+ * @param parameter
+ *      the processor
+ * @return
+ */
+void *OperatingSystem::runnerProcessor(void *parameter){
+	Processor &cpu = *static_cast<Processor*>(parameter);
+	OperatingSystem &process = *cpu.system;
+	currentProcessor = &cpu;
+	chrono::milliseconds quantum(process.configPtr->getCPUQuantumNumber());
+	while (process.shutdown == false){
+		//any processor can take the interrupt for finished I/O or release a job that is due
+		resumeBlocked(process, false);
+		releaseJobs(process);
+		ProcessControlBlock *block = nextReady(cpu);
+		if (block == NULL){
+			block = stealReady(cpu, 1);
+		}
+		if (block == NULL){
+			waitForWork(process.policy->nextRelease(Time::now() + quantum));
+			continue;
+		}
+		runQuantum(cpu, block);
+		balanceLoad(cpu);
+	}
+	return NULL;
+}
 
-				if (quantity > 0){
-					temp.push_back("M");
-					temp.push_back("allocate");
-					temp.push_back(to_string(quantity));
-				}
-			}else if (ptr->mDescriptor == "block"){
-				quantity = ((ptr->configPtr->getMemoryTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getMemoryTime()));
+/**
+ * @name leastLoaded
+ *
+ * @details finds the processor with the fewest processes queued, new processes go there
+ * @param process
+ * @return
+ */
+Processor &OperatingSystem::leastLoaded(OperatingSystem &process){
+	Processor *least = &process.processors.front();
+	for (Processor &cpu : process.processors){
+		if (cpu.queued < least->queued){
+			least = &cpu;
+		}
+	}
+	return *least;
+}
 
-				quantity = (((ptr->configPtr->getMemoryTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getMemoryTime()));
+/**
+ * @name stealReady
+ *
+ * @details takes the next process of the processor with the most queued
+ * @param cpu
+ *      processor taking the process
+ * @param margin
+ *      how many more processes the other processor has to have queued
+ * @return
+ *      NULL if no processor has enough queued
+ */
+ProcessControlBlock *OperatingSystem::stealReady(Processor &cpu, int margin){
+	Processor *busiest = NULL;
+	for (Processor &other : cpu.system->processors){
+		if (&other != &cpu && other.queued >= cpu.queued + margin && (busiest == NULL || other.queued > busiest->queued)){
+			busiest = &other;
+		}
+	}
+	if (busiest == NULL){
+		return NULL;
+	}
+	ProcessControlBlock *block = cpu.system->policy->steal(cpu, *busiest);
+	if (block == NULL){
+		return NULL;
+	}
+	cpu.steals++;
+	return block;
+}
 
-				if (quantity > 0){
-					temp.push_back("M");
-					temp.push_back("block");
-					temp.push_back(to_string(quantity));
-				}
-			}
-		}else if (ptr->mCode == "P"){ //if operation is P, calculate new run time
-			if (ptr->mDescriptor == "run"){
-				quantity = ((ptr->configPtr->getProcessorTime() * stoi(ptr->mCycle)) / (ptr->configPtr->getProcessorTime()));
+/**
+ * @name balanceLoad
+ *
+ * @details every few quanta takes a process from a processor with at least two more queued
+ * @param cpu
+ */
+void OperatingSystem::balanceLoad(Processor &cpu){
+	if (++cpu.quanta < BALANCE_QUANTA){
+		return;
+	}
+	cpu.quanta = 0;
+	ProcessControlBlock *block = stealReady(cpu, 2);
+	if (block != NULL){
+		readyProcess(cpu, block);
+	}
+}
 
-				quantity = (((ptr->configPtr->getProcessorTime() * stoi(ptr->mCycle)) - (ptr->configPtr->getCPUQuantumNumber())) / (ptr->configPtr->getProcessorTime()));
+/**
+ * @name releaseJobs
+ *
+ * @details queues every process the policy has due to come back on the processor it last
+ *          ran on, under EDF the next job of a process with a period
+ * @param process
+ */
+void OperatingSystem::releaseJobs(OperatingSystem &process){
+	for (ProcessControlBlock *block = process.policy->release(); block != NULL; block = process.policy->release()){
+		readyProcess(process.processors[block->processor], block);
+	}
+}
 
-				if (quantity > 0){
-					temp.push_back("P");
-					temp.push_back("run");
-					temp.push_back(to_string(quantity));
-				}
-			}
-		}
-        // for all remaining operations, place at the end of vector
-		for (unsigned int j = 0; j < ptr->scheduleVector.size(); j++){
-			if (ptr->scheduleVector[j] == "A" && ptr->scheduleVector[j + 1] == "begin"){
-				count = j;
-				break;
-			}
-			temp.push_back(ptr->scheduleVector[j]);	
-		}
-        // pop all operations that were just placed at the end of vector
-		for (int j = 0; j < count; j++){
-			reverse(ptr->scheduleVector.begin(), ptr->scheduleVector.end());
-			ptr->scheduleVector.pop_back();
-			reverse(ptr->scheduleVector.begin(), ptr->scheduleVector.end());
-		}
-        //push everything to schedule vector
-		for (unsigned int j = 0; j < temp.size(); j++){
-			ptr->scheduleVector.push_back(temp[j]);
+/**
+ * @name reportProcessors
+ *
+ * @details prints how busy each processor was and how many processes it took from others
+ * @param process
+ */
+void OperatingSystem::reportProcessors(OperatingSystem &process){
+	double elapsed = calculateTime(timeInit, Time::now());
+	double busy = 0;
+	for (const Processor &cpu : process.processors){
+		int quanta = 0;
+		for (const ReadyLevel &level : cpu.readyLevels){
+			quanta += level.quanta;
 		}
+		double seconds = chrono::duration<double>(cpu.busy).count();
+		busy += seconds;
+		ostringstream line;
+		line << fixed << setprecision(6) << "OS: processor " << cpu.id << " ran " << quanta << " quanta for " << seconds << " seconds, "
+			<< setprecision(1) << 100 * seconds / elapsed << "% busy, took " << cpu.steals << " processes from other processors";
+		logLine(elapsed, line.str());
 	}
-	pthread_mutex_unlock(&mutexRR);
+	ostringstream total;
+	total << fixed << setprecision(2) << "OS: " << process.processors.size() << " processors were busy " << busy / elapsed << " of " << process.processors.size() << " at a time on average";
+	logLine(elapsed, total.str());
 }
+
 /**
- * @name loaderRRInterrupt
+ * @name runBurst
  *
- * @details loader function for RR interrupt
- * @param ptr
+ * @details runs the processing action the process is on until it is done or the quantum
+ *          ends, the time left is kept so the next quantum carries on from there. Under SRTF
+ *          and EDF a process that goes first being queued ends it early
+ * @param cpu
+ *      the processor it runs on
+ * @param block
+ * @param quantumEnd
+ *      when the quantum of the process runs out
+ * @param ran
+ *      processor time of the quantum, the slice that went by is added
+ * @return
+ *      true if the processing action is done
  */
-void OperatingSystem::loaderRRInterrupt(OperatingSystem* ptr){
-	void *threadPtr;
-	pthread_t threadID;
-	pthread_attr_t attr;
-	pthread_attr_init(&attr);
-	threadPtr = ptr;
-	pthread_create(&threadID, &attr, ptr->runnerRRInterrupt, threadPtr);
-	pthread_join(threadID, NULL);
+bool OperatingSystem::runBurst(Processor &cpu, ProcessControlBlock *block, const chrono::high_resolution_clock::time_point quantumEnd, chrono::nanoseconds &ran){
+	OperatingSystem &process = *cpu.core;
+	const Operation &op = block->operations[block->programCounter];
+	if (block->remaining.count() == 0){
+		block->remaining = chrono::milliseconds(process.configPtr->getProcessorTime() * op.cycles);
+		logLine(calculateTime(timeInit, Time::now()), "Process " + to_string(block->id) + ": start processing action");
+	}
+	chrono::nanoseconds slice = min(block->remaining, chrono::duration_cast<chrono::nanoseconds>(quantumEnd - Time::now()));
+	//the quantum can run out between the check in runQuantum and here
+	if (slice.count() <= 0){
+		return false;
+	}
+
+	process.processorState = "RUNNING";
+	//under SRTF and EDF a process that goes first being queued ends it early
+	slice = cpu.system->policy->runSlice(cpu, slice);
+	block->remaining -= slice;
+	block->burst += slice;
+	ran += slice;
+	if (block->remaining.count() > 0){
+		process.processorState = "READY";
+		return false;
+	}
+	block->remaining = chrono::nanoseconds(0);
+	logLine(calculateTime(timeInit, Time::now()), "Process " + to_string(block->id) + ": end processing action");
+	return true;
 }
 
 /**
- * @name runnerRRInterrupt
+ * @name operationTime
  *
- * @details runner for RR interrupt
- * @param parameter
+ * @details gives how long an operation takes, its cycles times the cycle time of its device
+ * @param process
+ * @param operation
  * @return
+ *      zero for operations without a cycle time
  */
-void* OperatingSystem::runnerRRInterrupt(void *parameter){
-	OperatingSystem *opPtr = static_cast<OperatingSystem*>(parameter);
-	//run scheduler function for RR interrupt
-	scheduleRRInterrupt(opPtr->scheduleVector, opPtr);
-	pthread_exit(0);
-}
\ No newline at end of file
+chrono::nanoseconds OperatingSystem::operationTime(OperatingSystem &process, const Operation &operation){
+	int (Config::*cycleTime)() const = deviceTable[operation.device].cycleTime;
+	if (cycleTime == NULL){
+		return chrono::nanoseconds(0);
+	}
+	return chrono::milliseconds((process.configPtr->*cycleTime)() * operation.cycles);
+}
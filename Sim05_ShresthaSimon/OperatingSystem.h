@@ -15,16 +15,103 @@
 #include "config.h"
 #include "metadata.h"
 #include "resourceManager.h"
+#include "processTable.h"
+#include "fifoRing.h"
+#include "lotteryTree.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <random>
+#include <set>
 #include <thread>				
 #include <pthread.h>			
 #include <semaphore.h>			
 
 using namespace std;
+//what a scheduling policy keeps for each process, every policy has its own kind
+struct PolicyState
+{
+	virtual ~PolicyState();
+};
+
+//a process under round robin, remembers where it stopped when its quantum ran out
+struct ProcessControlBlock
+{
+	int id; //0 until the process first runs
+	vector<Operation> operations;
+	size_t programCounter; //operation to run next
+	chrono::nanoseconds remaining; //processor time left on the operation, zero if it has not started
+	int processor; //processor the process last ran on, it goes back there after I/O
+	size_t order; //order the process was admitted in
+	chrono::nanoseconds cpuTime; //processor time the process had, only its processing actions
+	ProcessControlBlock *nextQueued; //next process in the inbox of a processor
+	chrono::nanoseconds work; //time the operations from the program counter on take
+	chrono::nanoseconds burst; //processor time since the process started or came back from I/O
+	unique_ptr<PolicyState> state; //what the scheduling policy keeps for the process, NULL under RR
+};
+
+//CFS, STRIDE, SRTF and EDF order, lowest key first then the order processes were admitted in,
+//the key is kept in the state of the tree policy
+struct KeyBefore
+{
+	bool operator()(const ProcessControlBlock *a, const ProcessControlBlock *b) const;
+};
+
+//a queue of ready processes, RR has one and MLFQ one per priority level
+struct ReadyLevel
+{
+	FifoRing<ProcessControlBlock*> ready;
+	int quanta; //quanta started from this level
+	int demotions; //processes that used a whole quantum and moved down
+	chrono::nanoseconds used; //time processes from this level held the processor
+};
+
+class OperatingSystem;
+class SchedulerPolicy;
+
+//one simulated processor with its own ready queue, the first one runs on the thread that
+//loads programs and the others on threads of their own
+struct Processor
+{
+	int id;
+	OperatingSystem *system; //operating system the processor belongs to
+	OperatingSystem *core; //current operation and state of this processor, used by the runner
+	pthread_t thread;
+	//RR and MLFQ levels, only the processor adds to them and any processor takes from them
+	deque<ReadyLevel> readyLevels;
+	//processes queued by other threads, a stack the processor moves to its levels
+	atomic<ProcessControlBlock*> inbox;
+	int boostEpoch; //last MLFQ boost the processor has done
+	pthread_mutex_t lock; //guards the tree and the lottery, neither can be shared without one
+	set<ProcessControlBlock*, KeyBefore> orderedQueue;
+	//LOTTERY tickets of the ready processes, a slot for every process in admission order
+	LotteryTree lottery;
+	vector<ProcessControlBlock*> lotterySlots;
+	mt19937_64 lotteryDraw;
+	atomic<int> queued; //processes waiting on the processor, used to pick one to take from
+	//CFS, STRIDE and LOTTERY state of the ready queue
+	chrono::nanoseconds minVruntime;
+	double fairClock; //seconds of processor time each unit of weight is owed
+	long long fairWeight; //weight ready or running
+	int quanta; //quanta run since work was last balanced
+	chrono::nanoseconds busy; //processor time of the processes it ran, not their device waits
+	int steals; //processes taken from other processors
+	//SRTF and EDF state, guarded by the lock
+	ProcessControlBlock *kept; //process still first when its quantum ran out, it runs on
+	ProcessControlBlock *running; //NULL if the processor is not running a process
+	chrono::nanoseconds runningKey; //key of the running process when it started
+	chrono::high_resolution_clock::time_point runningSince;
+	bool preempt; //a process that goes first was queued while one was running
+	pthread_cond_t wakeup; //wakes the processor out of a processing action when preempt is set
+};
+
 class OperatingSystem
 {
 
 public:
     chrono::high_resolution_clock::time_point programStart;
+    //run input and output in the background while other processes use the processor
+    bool asyncIO = false;
     //constructor
     OperatingSystem();
     OperatingSystem(Config *config, MetaData *metadata, Resource *resource);
@@ -33,14 +120,14 @@ public:
     void setTimerStatus(bool t);
     bool getTimerStatus() const;
     //thread functions
-    static void threadUsage(vector<string> metaVect, OperatingSystem &process);
+    static void threadUsage(const vector<Operation> &metaVect, OperatingSystem &process);
     static void timerUsage(OperatingSystem* ptr);
     static void *runner(void *parameter);
     //timer functions
     static void getDelay(OperatingSystem* ptr, const int operationTime, const int cycleTime);
-    static void timer(OperatingSystem* ptr, const int operationTime, const int cycleTime);
     static void *runnerTimer(void *parameter);
     static double calculateTime(const chrono::high_resolution_clock::time_point timeInitial, const chrono::high_resolution_clock::time_point timeFinal);
+    static void logLine(double timeStamp, const string &text);
     //memory functions
     static unsigned int memoryManagement(OperatingSystem *ptr);
     // process functions
@@ -50,19 +137,39 @@ public:
     static void processOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp);
     static void inputOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp);
     static void outputOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp);
+    static void deviceOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp, const char *direction);
+    static void deviceIO(OperatingSystem *ptr, const Operation &operation, int processID, const chrono::high_resolution_clock::time_point timeInitial, const char *direction);
+    //asynchronous I/O functions
+    static bool dispatch(OperatingSystem &process);
+    static void startIO(OperatingSystem &process);
+    static void startIO(OperatingSystem &process, ProcessControlBlock *block);
+    static void *runnerIO(void *parameter);
+    static bool resumeBlocked(OperatingSystem &process, bool wait);
     static void memoryOP(OperatingSystem *ptr, const chrono::high_resolution_clock::time_point timeInitial, chrono::high_resolution_clock::time_point timeFinal, double timeStamp);
     //STR functions
     static void *runnerSTR(void *parameter);
     static void loaderSTR(OperatingSystem* ptr);
-    static void scheduleSIOF(vector<string> threadVector, OperatingSystem *ptr);
-    static void scheduleSTR(vector<string> threadVector, OperatingSystem *ptr);
+    static void nextProcessSTR(OperatingSystem &process);
+    static void scheduleSTR(const vector<Operation> &threadVector, OperatingSystem *ptr);
     // RR functions
     static void *runnerRR(void *parameter);
     static void loaderRR(OperatingSystem* ptr);
-    static void scheduleRR(vector<string> threadVector, OperatingSystem *ptr);
-    static void scheduleRRInterrupt(vector<string> threadVector, OperatingSystem *ptr);
-    static void loaderRRInterrupt(OperatingSystem* ptr);
-    static void *runnerRRInterrupt(void *parameter);
+    static void scheduleRR(const vector<Operation> &threadVector, OperatingSystem *ptr);
+    static void admitRR(OperatingSystem *ptr, const vector<Operation> &operations);
+    static void runQuantum(Processor &cpu, ProcessControlBlock *block);
+    static void readyProcess(Processor &cpu, ProcessControlBlock *block);
+    static ProcessControlBlock *nextReady(Processor &cpu);
+    //processor functions
+    static void startProcessors(OperatingSystem &process, int count, size_t capacity, int levels);
+    static void stopProcessors(OperatingSystem &process);
+    static void *runnerProcessor(void *parameter);
+    static Processor &leastLoaded(OperatingSystem &process);
+    static ProcessControlBlock *stealReady(Processor &cpu, int margin);
+    static void balanceLoad(Processor &cpu);
+    static void releaseJobs(OperatingSystem &process);
+    static void reportProcessors(OperatingSystem &process);
+    static bool runBurst(Processor &cpu, ProcessControlBlock *block, const chrono::high_resolution_clock::time_point quantumEnd, chrono::nanoseconds &ran);
+    static chrono::nanoseconds operationTime(OperatingSystem &process, const Operation &operation);
 
 private:
 	int processID = 0;
@@ -73,12 +180,20 @@ private:
 	Config *configPtr;
 	MetaData *metaDataPtr;
 	Resource *resourceManager;
-	string mCode;
-	string mDescriptor;
-	string mCycle;
+	Operation current;
 	string processorState;
-	string s1, s2, s3, s4, s5, s6;
-	vector<string> scheduleVector;
+	Operation systemStart, systemEnd;
+	vector<Operation> scheduleVector;
+	ProcessTable processTable;
+	deque<ProcessControlBlock> processBlocks;
+	//RR, MLFQ, CFS, STRIDE, LOTTERY, SRTF and EDF processes are queued on the processors
+	deque<Processor> processors;
+	//decides how the processors queue and pick processes, NULL under STR
+	SchedulerPolicy *policy = NULL;
+	//processes that are ready or running, not ones waiting on I/O
+	atomic<int> runnableBlocks{0};
+	atomic<bool> shutdown{false};
+	atomic<int> startedProcesses{0};
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file benchmarkData.cpp
+ *
+ * @brief generated metadata shared by the benchmarks
+ *
+ */
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include "benchmarkData.h"
+
+using namespace std;
+
+//operations in each generated process between A{begin} and A{finish}
+static const char *const processBody[] = {
+	"P{run}11", "M{allocate}2", "I{hard drive}9", "P{run}6", "O{monitor}4",
+	"M{block}3", "I{keyboard}5", "P{run}7", "O{printer}8", "O{hard drive}6"
+};
+static const int BODY_SIZE = sizeof(processBody) / sizeof(processBody[0]);
+
+/**
+ * @name writeMetadata
+ *
+ * @details writes a metadata file with at least operationCount operations
+ *
+ * @param path
+ * @param operationCount
+ */
+void writeMetadata(const string &path, long operationCount)
+{
+	ofstream file(path, ios::out | ios::trunc);
+	long written = 2;
+
+	if (!file)
+	{
+		cerr << "Error, can not write " << path << endl;
+		exit(0);
+	}
+	file << "Start Program Meta-Data Code:\nS{begin}0; ";
+	while (written < operationCount)
+	{
+		file << "A{begin}0; ";
+		for (int i = 0; i < BODY_SIZE; i++)
+			file << processBody[i] << "; ";
+		file << "A{finish}0;\n";
+		written += BODY_SIZE + 2;
+	}
+	file << "S{finish}0.\nEnd Program Meta-Data Code.\n";
+}
+/**
+ * @name operationsForSize
+ *
+ * @details works out how many operations writeMetadata needs to write about this many bytes
+ *
+ * @param bytes
+ * @return
+ */
+long operationsForSize(long bytes)
+{
+	//A{begin}0; and A{finish}0; with the new line take 23 bytes
+	long processBytes = 23;
+
+	for (int i = 0; i < BODY_SIZE; i++)
+		processBytes += strlen(processBody[i]) + 2;
+	return bytes / processBytes * (BODY_SIZE + 2);
+}
+/**
+ * @name benchmarkFile
+ *
+ * @details makes an empty file in /tmp, the caller unlinks it when done
+ *
+ * @return
+ *      path of the file
+ */
+string benchmarkFile()
+{
+	char path[] = "/tmp/benchmarkXXXXXX";
+	int fd = mkstemp(path);
+
+	if (fd < 0)
+	{
+		cerr << "Error, can not create a file in /tmp" << endl;
+		exit(0);
+	}
+	close(fd);
+	return path;
+}
+//
+double elapsed(BenchmarkClock::time_point start)
+{
+	return chrono::duration<double>(BenchmarkClock::now() - start).count();
+}
@@ -0,0 +1,28 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file benchmarkData.h
+ *
+ * @brief generated metadata shared by the benchmarks
+ *
+ */
+#ifndef BENCHMARKDATA_H
+#define BENCHMARKDATA_H
+
+#include <string>
+#include <chrono>
+
+using namespace std;
+
+typedef chrono::steady_clock BenchmarkClock;
+
+//writes a metadata file of whole processes with at least operationCount operations
+void writeMetadata(const string &path, long operationCount);
+//operations in a generated file of about this many bytes
+long operationsForSize(long bytes);
+//makes an empty file in /tmp for the generated metadata
+string benchmarkFile();
+//seconds since start
+double elapsed(BenchmarkClock::time_point start);
+
+#endif // !BENCHMARKDATA_H
@@ -0,0 +1,105 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file benchmarkDispatch.cpp
+ *
+ * @brief operation dispatch benchmark
+ *
+ * @details times handing an empty job to a thread four ways. A new thread per operation is
+ *          how operations used to run, handing a job to a worker and waiting on it is the
+ *          cost an operation paid on the pool, queueing jobs without waiting on each one is
+ *          how background I/O runs and calling the job on the caller's thread is how
+ *          operations and loaders run now
+ *
+ * @note requires worker pool class files
+ */
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <cstdlib>
+#include <pthread.h>
+#include <semaphore.h>
+#include "workerPool.h"
+#include "benchmarkData.h"
+
+using namespace std;
+
+//the simulator keeps dispatch under this many microseconds
+static const double TARGET_MICROSECONDS = 1.0;
+
+static atomic<long> jobsDone(0);
+static sem_t jobFinished;
+
+//job that only counts itself
+static void *emptyJob(void*)
+{
+	jobsDone++;
+	return NULL;
+}
+//job that also wakes the thread waiting on it
+static void *waitedJob(void*)
+{
+	jobsDone++;
+	sem_post(&jobFinished);
+	return NULL;
+}
+//
+static void printResult(const string &name, double seconds, long jobs)
+{
+	double microseconds = seconds * 1e6 / jobs;
+	cout << setw(34) << left << name << right << setw(10) << microseconds
+		<< (microseconds < TARGET_MICROSECONDS ? "  under target" : "") << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	long jobs = 100000;
+	WorkerPool pool(4, 64);
+	BenchmarkClock::time_point start;
+
+	if (argc == 2 && atol(argv[1]) > 0)
+		jobs = atol(argv[1]);
+	else if (argc != 1)
+	{
+		cerr << "Error! Usage: ./benchmarkDispatch [jobs]" << endl;
+		return 0;
+	}
+	sem_init(&jobFinished, 0, 0);
+	cout << fixed << setprecision(3);
+	cout << setw(34) << left << "dispatch" << right << setw(10) << "usec/job" << endl;
+
+	//thread creation is slow enough that a tenth of the jobs is plenty
+	start = BenchmarkClock::now();
+	for (long i = 0; i < jobs / 10; i++)
+	{
+		pthread_t thread;
+		pthread_create(&thread, NULL, emptyJob, NULL);
+		pthread_join(thread, NULL);
+	}
+	printResult("new thread per job", elapsed(start), jobs / 10);
+
+	start = BenchmarkClock::now();
+	for (long i = 0; i < jobs; i++)
+	{
+		pool.submit(waitedJob, NULL);
+		sem_wait(&jobFinished);
+	}
+	printResult("pool worker, waiting on each job", elapsed(start), jobs);
+
+	jobsDone = 0;
+	start = BenchmarkClock::now();
+	for (long i = 0; i < jobs; i++)
+		pool.submit(emptyJob, NULL);
+	while (jobsDone < jobs)
+		sched_yield();
+	printResult("pool worker, queued in the back", elapsed(start), jobs);
+
+	start = BenchmarkClock::now();
+	for (long i = 0; i < jobs; i++)
+		emptyJob(NULL);
+	printResult("caller's thread", elapsed(start), jobs);
+
+	sem_destroy(&jobFinished);
+	return 0;
+}
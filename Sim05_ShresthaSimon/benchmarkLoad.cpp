@@ -0,0 +1,101 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file benchmarkLoad.cpp
+ *
+ * @brief metadata load benchmark
+ *
+ * @details writes generated metadata files of 1K, 1M and 10M operations and times the mapped
+ *          loader against the old loadMetadataFile, readMetadataFile and getMetadataComponents
+ *          path. The old path is quadratic so it is only run up to --old-limit operations,
+ *          100K by default, at 1M operations it takes minutes
+ *
+ * @note requires metadata class files
+ */
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+#include "metadata.h"
+#include "benchmarkData.h"
+
+using namespace std;
+
+//time to load a file with the mapped loader
+static double loadMapped(const string &path, size_t &operations)
+{
+	MetaData metaData;
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+
+	metaData.mapMetadataFile(path);
+	operations = metaData.getOperations().size();
+	return elapsed(start);
+}
+//time to load a file with the old string loader
+static double loadOld(const string &path, size_t &operations)
+{
+	MetaData metaData;
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+
+	metaData.readMetadataFile(metaData.loadMetadataFile(path));
+	metaData.getMetadataComponents(metaData.getmetaVector());
+	operations = metaData.getmetaVector().size() / 3;
+	return elapsed(start);
+}
+
+int main(int argc, char *argv[])
+{
+	vector<long> sizes;
+	long oldLimit = 100000;
+	string path;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (string(argv[i]) == "--old-limit" && i + 1 < argc)
+			oldLimit = atol(argv[++i]);
+		else if (atol(argv[i]) > 0)
+			sizes.push_back(atol(argv[i]));
+		else
+		{
+			cerr << "Error! Usage: ./benchmarkLoad [--old-limit operations] [operations ...]" << endl;
+			return 0;
+		}
+	}
+	if (sizes.empty())
+	{
+		sizes.push_back(1000);
+		sizes.push_back(1000000);
+		sizes.push_back(10000000);
+	}
+	path = benchmarkFile();
+
+	cout << fixed << setprecision(4);
+	cout << setw(12) << "operations" << setw(14) << "mapped (s)" << setw(14) << "old (s)" << setw(10) << "speedup" << endl;
+	for (size_t i = 0; i < sizes.size(); i++)
+	{
+		size_t mappedCount, oldCount;
+		double mapped, old;
+
+		writeMetadata(path, sizes[i]);
+		//the first mapped load also warms the page cache for both loaders
+		loadMapped(path, mappedCount);
+		mapped = loadMapped(path, mappedCount);
+		cout << setw(12) << mappedCount << setw(14) << mapped;
+		if (sizes[i] <= oldLimit)
+		{
+			old = loadOld(path, oldCount);
+			cout << setw(14) << old << setw(9) << setprecision(1) << old / mapped << "x" << setprecision(4);
+			if (oldCount != mappedCount)
+				cout << "  old path read " << oldCount << " operations";
+		}
+		else
+		{
+			cout << setw(14) << "skipped";
+		}
+		cout << endl;
+	}
+	unlink(path.c_str());
+	return 0;
+}
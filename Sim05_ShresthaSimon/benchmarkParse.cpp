@@ -0,0 +1,79 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file benchmarkParse.cpp
+ *
+ * @brief parallel metadata parser scaling benchmark
+ *
+ * @details writes one large generated metadata file and loads it with mapMetadataFile split
+ *          across 1, 2, 4, 8 and 16 threads, printing the speedup over one thread. Threads
+ *          past the number of cores only show the cost of splitting
+ *
+ * @note requires metadata class files
+ */
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <unistd.h>
+#include "metadata.h"
+#include "benchmarkData.h"
+
+using namespace std;
+
+//most threads the benchmark goes up to
+static const int MAX_THREADS = 16;
+
+//best of two loads with the parser limited to threads
+static double loadWith(const string &path, int threads, size_t &operations)
+{
+	double best = 0;
+
+	MetaData::setParseThreads(threads);
+	for (int run = 0; run < 2; run++)
+	{
+		MetaData metaData;
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+
+		metaData.mapMetadataFile(path);
+		operations = metaData.getOperations().size();
+		double time = elapsed(start);
+		if (run == 0 || time < best)
+			best = time;
+	}
+	return best;
+}
+
+int main(int argc, char *argv[])
+{
+	long megabytes = 256;
+	size_t operations;
+	double single = 0;
+	string path;
+
+	if (argc == 3 && string(argv[1]) == "--megabytes" && atol(argv[2]) > 0)
+		megabytes = atol(argv[2]);
+	else if (argc != 1)
+	{
+		cerr << "Error! Usage: ./benchmarkParse [--megabytes N]" << endl;
+		return 0;
+	}
+	path = benchmarkFile();
+	writeMetadata(path, operationsForSize(megabytes << 20));
+
+	cout << megabytes << " MB of metadata, " << sysconf(_SC_NPROCESSORS_ONLN) << " cores online" << endl;
+	cout << fixed << setprecision(4);
+	cout << setw(8) << "threads" << setw(12) << "time (s)" << setw(10) << "speedup" << setw(12) << "operations" << endl;
+	//the first load also warms the page cache
+	loadWith(path, 1, operations);
+	for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+	{
+		double time = loadWith(path, threads, operations);
+		if (threads == 1)
+			single = time;
+		cout << setw(8) << threads << setw(12) << time << setw(9) << setprecision(2) << single / time << "x"
+			<< setw(12) << operations << setprecision(4) << endl;
+	}
+	unlink(path.c_str());
+	return 0;
+}
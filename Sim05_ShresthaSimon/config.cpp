@@ -8,6 +8,9 @@
  * @note Requires Config.h
  */
 #include "config.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace std;
 
 //setter functions
@@ -36,273 +39,383 @@ void Config::setMouseResources(string mouse)
 	mouseResources = stoi(mouse);
 }
 //
+//first bytes of a configuration snapshot
+static const char SNAPSHOT_MAGIC[4] = {'C', 'F', 'C', '1'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+//start of a .confc file, followed by the ints and then each string as a length and its characters
+struct ConfigSnapshotHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t sourceSize;
+	int64_t sourceSeconds;
+	int64_t sourceNanoseconds;
+	uint32_t intCount;
+	uint32_t stringCount;
+};
+
+//position of every key in the key table
+enum ConfigKeyId
+{
+	KEY_VERSION,
+	KEY_FILE_PATH,
+	KEY_MONITOR_TIME,
+	KEY_PROCESSOR_TIME,
+	KEY_MOUSE_TIME,
+	KEY_HARDDRIVE_TIME,
+	KEY_KEYBOARD_TIME,
+	KEY_MEMORY_TIME,
+	KEY_PRINTER_TIME,
+	KEY_LOG,
+	KEY_LOG_FILE_PATH,
+	KEY_SYSTEM_MEMORY_K,
+	KEY_SYSTEM_MEMORY_M,
+	KEY_SYSTEM_MEMORY_G,
+	KEY_BLOCK_SIZE_K,
+	KEY_BLOCK_SIZE_M,
+	KEY_BLOCK_SIZE_G,
+	KEY_PRINTER_QUANTITY,
+	KEY_HARDDRIVE_QUANTITY,
+	KEY_KEYBOARD_QUANTITY,
+	KEY_MONITOR_QUANTITY,
+	KEY_MOUSE_QUANTITY,
+	KEY_SCHEDULING_CODE,
+	KEY_QUANTUM_NUMBER,
+	KEY_PROCESSOR_COUNT,
+	KEY_BURST_WEIGHT,
+	KEY_COUNT
+};
+
+//every key that can appear in a configuration file, in the same order as ConfigKeyId
+const ConfigKey Config::configKeys[KEY_COUNT] = {
+	{"Version/Phase", CONFIG_STRING, NULL, &Config::version, 1, NULL, NULL, "Error! Incorrect Version/Phase Format."},
+	{"File Path", CONFIG_PATH, NULL, &Config::metadataFilePath, 1, ".mdf", ".mdb", "Error! Missing .mdf"},
+	{"Monitor display time {msec}", CONFIG_INT, &Config::monitorDisplayTime, NULL, 1, NULL, NULL, "Error! Incorrect Monitor Format."},
+	{"Processor cycle time {msec}", CONFIG_INT, &Config::processorCycleTime, NULL, 1, NULL, NULL, "Error! Incorrect Processor Format."},
+	{"Mouse cycle time {msec}", CONFIG_INT, &Config::mouseCycleTime, NULL, 1, NULL, NULL, "Error! Incorrect Mouse Format."},
+	{"Hard drive cycle time {msec}", CONFIG_INT, &Config::harddriveCycleTime, NULL, 1, NULL, NULL, "Error! Incorrect hard drive Format."},
+	{"Keyboard cycle time {msec}", CONFIG_INT, &Config::keyboardCycleTime, NULL, 1, NULL, NULL, "Error! Incorrect Keyboard Format."},
+	{"Memory cycle time {msec}", CONFIG_INT, &Config::memoryCycleTime, NULL, 1, NULL, NULL, "Error! Incorrect Memory Format."},
+	{"Printer cycle time {msec}", CONFIG_INT, &Config::printerCycleTime, NULL, 1, NULL, NULL, "Error! Incorrect Printer Format."},
+	{"Log", CONFIG_STRING, NULL, &Config::logSetting, 1, NULL, NULL, "Error! Incorrect Log Format."},
+	{"Log File Path", CONFIG_PATH, NULL, &Config::logFilePath, 1, ".lgf", NULL, "Error! Missing .lgf"},
+	{"System memory {kbytes}", CONFIG_INT, &Config::systemMemorySize, &Config::systemMemoryType, 1, NULL, NULL, "Error! Incorrect System Memory Format."},
+	{"System memory {Mbytes}", CONFIG_INT, &Config::systemMemorySize, &Config::systemMemoryType, 1000, NULL, NULL, "Error! Incorrect System Memory Format."},
+	{"System memory {Gbytes}", CONFIG_INT, &Config::systemMemorySize, &Config::systemMemoryType, 1000000, NULL, NULL, "Error! Incorrect System Memory Format."},
+	{"Memory block size {kbytes}", CONFIG_INT, &Config::memoryBlockSize, &Config::memoryBlockType, 1, NULL, NULL, "Error! Incorrect Memory block size Format."},
+	{"Memory block size {Mbytes}", CONFIG_INT, &Config::memoryBlockSize, &Config::memoryBlockType, 1000, NULL, NULL, "Error! Incorrect Memory block size Format."},
+	{"Memory block size {Gbytes}", CONFIG_INT, &Config::memoryBlockSize, &Config::memoryBlockType, 1000000, NULL, NULL, "Error! Incorrect Memory block size Format."},
+	{"Printer quantity", CONFIG_INT, &Config::printerResources, NULL, 1, NULL, NULL, "Error! Incorrect printer resource format."},
+	{"Hard drive quantity", CONFIG_INT, &Config::harddriveResources, NULL, 1, NULL, NULL, "Error! Incorrect hard drive resource format."},
+	{"Keyboard quantity", CONFIG_INT, &Config::keyboardResources, NULL, 1, NULL, NULL, "Error! Incorrect keyboard resource format."},
+	{"Monitor quantity", CONFIG_INT, &Config::monitorResources, NULL, 1, NULL, NULL, "Error! Incorrect monitor resource format."},
+	{"Mouse quantity", CONFIG_INT, &Config::mouseResources, NULL, 1, NULL, NULL, "Error! Incorrect mouse resource format."},
+	{"CPU Scheduling Code", CONFIG_STRING, NULL, &Config::schedulingCode, 1, NULL, NULL, "Error! Incorrect Scheduling Algo format."},
+	{"Processor Quantum Number {msec}", CONFIG_INT, &Config::quantumNumber, NULL, 1, NULL, NULL, "Error! Incorrect quantum num format"},
+	{"Processor count", CONFIG_INT, &Config::processorCount, NULL, 1, NULL, NULL, "Error! Incorrect processor count format."},
+	{"Burst prediction weight {%}", CONFIG_INT, &Config::burstWeight, NULL, 1, NULL, NULL, "Error! Incorrect burst prediction weight format."}
+};
+
+//fields saved in a snapshot, any new field has to be added here
+int Config::* const Config::snapshotInts[] = {
+	&Config::printerCycleTime, &Config::processorCycleTime, &Config::keyboardCycleTime,
+	&Config::monitorDisplayTime, &Config::mouseCycleTime, &Config::harddriveCycleTime,
+	&Config::memoryCycleTime, &Config::printerResources, &Config::harddriveResources,
+	&Config::keyboardResources, &Config::monitorResources, &Config::mouseResources,
+	&Config::systemMemorySize, &Config::memoryBlockSize, &Config::quantumNumber, &Config::processorCount,
+	&Config::burstWeight
+};
+string Config::* const Config::snapshotStrings[] = {
+	&Config::version, &Config::metadataFilePath, &Config::systemMemoryType, &Config::logSetting,
+	&Config::logFilePath, &Config::configFilePath, &Config::memoryBlockType, &Config::schedulingCode
+};
+#define SNAPSHOT_INT_COUNT (uint32_t) (sizeof(snapshotInts) / sizeof(snapshotInts[0]))
+#define SNAPSHOT_STRING_COUNT (uint32_t) (sizeof(snapshotStrings) / sizeof(snapshotStrings[0]))
+/**
+ * @name findKey
+ *
+ * @details looks up the left side of a configuration line, the hash picks the only key it could
+ *          be and then the name is compared to make sure
+ *
+ * @param name
+ *      start of the left side
+ *
+ * @param length
+ *      length of the left side
+ *
+ * @return the key, NULL if it is not a configuration key
+ */
+const ConfigKey *Config::findKey(const char *name, size_t length)
+{
+	uint32_t hash = 2166136261u;
+	int id;
+
+	for (size_t i = 0; i < length; i++)
+		hash = (hash ^ (uint8_t) name[i]) * 16777619u;
+	switch (hash)
+	{
+	case configHash("Version/Phase"): id = KEY_VERSION; break;
+	case configHash("File Path"): id = KEY_FILE_PATH; break;
+	case configHash("Monitor display time {msec}"): id = KEY_MONITOR_TIME; break;
+	case configHash("Processor cycle time {msec}"): id = KEY_PROCESSOR_TIME; break;
+	case configHash("Mouse cycle time {msec}"): id = KEY_MOUSE_TIME; break;
+	case configHash("Hard drive cycle time {msec}"): id = KEY_HARDDRIVE_TIME; break;
+	case configHash("Keyboard cycle time {msec}"): id = KEY_KEYBOARD_TIME; break;
+	case configHash("Memory cycle time {msec}"): id = KEY_MEMORY_TIME; break;
+	case configHash("Printer cycle time {msec}"): id = KEY_PRINTER_TIME; break;
+	case configHash("Log"): id = KEY_LOG; break;
+	case configHash("Log File Path"): id = KEY_LOG_FILE_PATH; break;
+	case configHash("System memory {kbytes}"): id = KEY_SYSTEM_MEMORY_K; break;
+	case configHash("System memory {Mbytes}"): id = KEY_SYSTEM_MEMORY_M; break;
+	case configHash("System memory {Gbytes}"): id = KEY_SYSTEM_MEMORY_G; break;
+	case configHash("Memory block size {kbytes}"): id = KEY_BLOCK_SIZE_K; break;
+	case configHash("Memory block size {Mbytes}"): id = KEY_BLOCK_SIZE_M; break;
+	case configHash("Memory block size {Gbytes}"): id = KEY_BLOCK_SIZE_G; break;
+	case configHash("Printer quantity"): id = KEY_PRINTER_QUANTITY; break;
+	case configHash("Hard drive quantity"): id = KEY_HARDDRIVE_QUANTITY; break;
+	case configHash("Keyboard quantity"): id = KEY_KEYBOARD_QUANTITY; break;
+	case configHash("Monitor quantity"): id = KEY_MONITOR_QUANTITY; break;
+	case configHash("Mouse quantity"): id = KEY_MOUSE_QUANTITY; break;
+	case configHash("CPU Scheduling Code"): id = KEY_SCHEDULING_CODE; break;
+	case configHash("Processor Quantum Number {msec}"): id = KEY_QUANTUM_NUMBER; break;
+	case configHash("Processor count"): id = KEY_PROCESSOR_COUNT; break;
+	case configHash("Burst prediction weight {%}"): id = KEY_BURST_WEIGHT; break;
+	default: return NULL;
+	}
+	if (strlen(configKeys[id].name) != length || memcmp(configKeys[id].name, name, length) != 0)
+		return NULL;
+	return &configKeys[id];
+}
 /**
- * @brief Parses through configuration file and assigns values rea to variables
+ * @brief Parses through configuration file and assigns values read to variables
+ *
+ * @details the whole file is read into one buffer and parsed in place. With useSnapshot the
+ *          parsed values are also saved to a .confc file next to the .conf file, which is read
+ *          instead of the .conf file as long as the .conf file has the same size and modified time
  *
  * @pre string configFilePath must be a .conf file
  *
  * @param configFilePath
  *        the configuration file input
  *
+ * @param useSnapshot
+ *        reuse or write the .confc snapshot
+ *
  */
-void Config::readConfigFile(string configFilePath) {
-    // open input file
-    ifstream configFile;
-    configFile.open(configFilePath);
-    // flag used to check if output file was entered
-    bool seenLogFile = false;
+void Config::readConfigFile(string configFilePath, bool useSnapshot) {
+    struct stat fileInfo;
+    string snapshotPath = configFilePath + "c";
+    string contents;
+    int fd = open(configFilePath.c_str(), O_RDONLY);
 
     // outputs error if file not found in the same directory
-    if(!configFile){
+    if(fd < 0 || fstat(fd, &fileInfo) != 0){
         cerr << "Error! Can't Find File" << endl;
         exit(1);
     }
+    // nothing has to be parsed if the snapshot is still up to date
+    if(useSnapshot && loadSnapshot(snapshotPath, fileInfo)){
+        close(fd);
+        return;
+    }
+    // read everything into one buffer
+    contents.resize(fileInfo.st_size);
+    size_t total = 0;
+    while(total < contents.size()){
+        ssize_t count = read(fd, &contents[total], contents.size() - total);
+        if(count <= 0){
+            break;
+        }
+        total += count;
+    }
+    contents.resize(total);
+    close(fd);
 
-    // vector hold entire file input and to parse through
-    vector<string>iterator;
-    //string to hold words being read in
-    string mark;
-
-    // inputs everything from file into vector line by line
-    while(getline(configFile, mark)){
-        iterator.push_back(mark);
+    parseConfig(contents.data(), contents.data() + contents.size());
+    if(useSnapshot){
+        saveSnapshot(snapshotPath, fileInfo);
     }
+}
+/**
+ * @name parseConfig
+ *
+ * @details checks the first and last line and assigns every line in between using the key table
+ *
+ * @param begin
+ *      start of the configuration file
+ *
+ * @param end
+ *      end of the configuration file
+ */
+void Config::parseConfig(const char *begin, const char *end) {
+    // flag used to check if output file was entered
+    bool seenLogFile = false;
+    // a new line at the very end does not start another line
+    const char *lastEnd = (end > begin && end[-1] == '\n') ? end - 1 : end;
+    const char *firstEnd = static_cast<const char*>(memchr(begin, '\n', lastEnd - begin));
     //if there is only the first and last line
-    if(iterator.size() < 2){
+    if(firstEnd == NULL){
         cerr << "Error! Missing lines in Configuration File." << endl;
         exit(0);
     }
+    const char *lastStart = static_cast<const char*>(memrchr(begin, '\n', lastEnd - begin)) + 1;
     // if the starting line does not exist
-    if(iterator.front() != "Start Simulator Configuration File"){
+    if(string(begin, firstEnd) != "Start Simulator Configuration File"){
         cerr << "Error! Configuration file is formatted incorrectly." << endl;
         exit(0);
     }
     // if ending line does not exist
-    if(iterator.back() != "End Simulator Configuration File"){
+    if(string(lastStart, lastEnd) != "End Simulator Configuration File"){
         cerr << "Error! Configuration file is formatted incorrectly." << endl;
         exit(0);
     }
-    // deleting first and last line as they are not needed to reading
-    iterator.erase(iterator.begin());
-    iterator.erase(iterator.end());
-    //character check to destinguish between left and right side
-    // left side will be everything before : and right side will be everything after
-    char delimiter = ':';
-
-
-    //iterates through entire vector and assigns values to variables
-    for(auto pnt = iterator.begin(); pnt != iterator.end(); pnt++){
-        string leftSide;
-        string rightSide;
-        // splits line into left and right side
-        splitString(*pnt, delimiter, leftSide, rightSide);
-        // trims right side so that there is no space before it
-        trim(rightSide);
-        // assignment portion
-        if(leftSide == "Version/Phase"){
-            try{
-                version = rightSide; //convert to float abd assign
 
+    // reused for every line so it is only allocated once
+    string rightSide;
+    //iterates through every line between the first and last line and assigns values to variables
+    for(const char *line = firstEnd + 1; line < lastStart; ){
+        const char *lineEnd = static_cast<const char*>(memchr(line, '\n', lastStart - line));
+        // left side will be everything before : and right side will be everything after
+        const char *colon = static_cast<const char*>(memchr(line, ':', lineEnd - line));
+        if(colon == NULL){
+            colon = lineEnd;
+        }
+        rightSide.clear();
+        for(const char *c = colon; c < lineEnd; c++){
+            if(*c != ':'){
+                rightSide.append(1, *c);
             }
-            catch (int e){
-                cerr << "Error! Incorrect Version/Phase Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "File Path"){
-            try{
-                string ending = rightSide; //create copy
-                ending = ending.erase(0, ending.size()-4); //leave only .mdf portion
-                if(ending == ".mdf"){
-                    metadataFilePath = rightSide; //if the ending is correct then assign
-                }else {
-                    cerr << "Error! Missing .mdf" << endl;
-                    exit(0);
-                }
-            }
-            catch (int e){
-                cerr << "Error! Incorrect File Path Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Monitor display time {msec}"){
-            try{
-                monitorDisplayTime = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Monitor Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Processor cycle time {msec}"){
-            try{
-                processorCycleTime = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Processor Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Mouse cycle time {msec}"){
-            try{
-                mouseCycleTime = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Mouse Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Hard drive cycle time {msec}"){
-            try{
-                harddriveCycleTime = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect hard drive Format." << endl;
-                exit(0);
-            }
+        }
+        // trims right side so that there is no space before it
+        trim(rightSide);
 
-        }else if(leftSide == "Keyboard cycle time {msec}"){
-            try{
-                keyboardCycleTime = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Keyboard Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Memory cycle time {msec}"){
+        const ConfigKey *key = findKey(line, colon - line);
+        if(key == NULL){
+            cerr << "Error! Config file not formatted correctly." << endl;
+            exit(0);
+        }
+        // assignment portion
+        if(key->type == CONFIG_STRING){
+            this->*(key->stringField) = rightSide;
+        }else if(key->type == CONFIG_INT){
             try{
-                memoryCycleTime = stoi(rightSide);
+                this->*(key->intField) = stoi(rightSide) * key->scale;
             }
-            catch (int e){
-                cerr << "Error! Incorrect Memory Format." << endl;
+            catch (const exception &e){
+                cerr << key->error << endl;
                 exit(0);
             }
-        }else if(leftSide == "Printer cycle time {msec}"){
-            try{
-                printerCycleTime = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Printer Format." << endl;
-                exit(0);
+            // memory sizes also keep which unit they were given in
+            if(key->stringField != NULL){
+                this->*(key->stringField) = key->name;
             }
-        }else if(leftSide == "Log"){
-            try{
-                logSetting = rightSide;
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Log Format." << endl;
+        }else{
+            // only the last 4 characters are checked, the .mdf, .mdb or .lgf portion
+            string ending = rightSide.size() >= 4 ? rightSide.substr(rightSide.size() - 4) : "";
+            if(ending != key->extension && (key->otherExtension == NULL || ending != key->otherExtension)){
+                cerr << key->error << endl;
                 exit(0);
             }
-        }else if(leftSide == "Log File Path"){
-            try{
-                string ending = rightSide;
-                ending = ending.erase(0, ending.size()-4);
-                if(ending == ".lgf"){
-                    logFilePath = rightSide;
-                }else {
-                    cerr << "Error! Missing .lgf" << endl;
-                    exit(0);
-                }
+            this->*(key->stringField) = rightSide;
+            if(key->stringField == &Config::logFilePath){
                 seenLogFile = true;
             }
-            catch (int e){
-                cerr << "Error! Incorrect Log File Path Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "System memory {kbytes}" || leftSide == "System memory {Mbytes}" || leftSide == "System memory {Gbytes}" ) {
-            try{
-                systemMemoryType = leftSide;
-                if(systemMemoryType.find("kbytes") != string::npos){
-                    systemMemorySize = stoi(rightSide);
-                }else if(systemMemoryType.find("Mbytes") != string::npos){
-                    systemMemorySize = stoi(rightSide) * 1000;
-                }else if(systemMemoryType.find("Gbytes") != string::npos){
-                    systemMemorySize = stoi(rightSide) * 1000000;
-                }
-            }
-            catch (int e) {
-                cerr << "Error! Incorrect System Memory Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Memory block size {kbytes}" || leftSide == "Memory block size {Mbytes}" || leftSide == "Memory block size {Gbytes}"){
-            try{
-                memoryBlockType = leftSide;
-                if(memoryBlockType.find("kbytes") != string::npos){
-                    memoryBlockSize = stoi(rightSide);
-                }else if(memoryBlockType.find("Mbytes") != string::npos){
-                    memoryBlockSize = stoi(rightSide) * 1000;
-                }else if(memoryBlockType.find("Gbytes") != string::npos){
-                    memoryBlockSize = stoi(rightSide) * 1000000;
-                }
-            }
-            catch (int e) {
-                cerr << "Error! Incorrect Memory block size Format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Printer quantity"){
-            try{
-                printerResources = stoi(rightSide);
-            }
-            catch(int e){
-                cerr << "Error! Incorrect printer resource format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Hard drive quantity"){
-            try{
-                harddriveResources = stoi(rightSide);
-            }
-            catch(int e){
-                cerr << "Error! Incorrect hard drive resource format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Keyboard quantity") {
-            try {
-                keyboardResources = stoi(rightSide);
-            }
-            catch (int e) {
-                cerr << "Error! Incorrect keyboard resource format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Monitor quantity") {
-            try {
-                monitorResources = stoi(rightSide);
-            }
-            catch (int e) {
-                cerr << "Error! Incorrect monitor resource format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Mouse quantity") {
-            try {
-                mouseResources = stoi(rightSide);
-            }
-            catch (int e) {
-                cerr << "Error! Incorrect mouse resource format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "CPU Scheduling Code"){
-            try{
-                schedulingCode = rightSide;
-            }
-            catch (int e){
-                cerr << "Error! Incorrect Scheduling Algo format." << endl;
-                exit(0);
-            }
-        }else if(leftSide == "Processor Quantum Number {msec}"){
-            try{
-                quantumNumber = stoi(rightSide);
-            }
-            catch (int e){
-                cerr << "Error! Incorrect quantum num format" << endl;
-                exit(0);
-            }
-        }else{
-            cerr << "Error! Config file not formatted correctly." << endl;
-            exit(0);
         }
+        line = lineEnd + 1;
     }
 
-    configFile.close();
     //chchking for if output file is in config file
     if((logSetting == "Log to Both" || logSetting == "Log to File") && !(seenLogFile)){
         cerr << "Error! Missing input for log option" << endl;
         exit(0);
     }
 }
+/**
+ * @name loadSnapshot
+ *
+ * @details reads a .confc snapshot, it is only used if it was made from a .conf file with the
+ *          same size and modified time
+ *
+ * @param snapshotPath
+ *      .confc file to read
+ *
+ * @param source
+ *      file info of the .conf file
+ *
+ * @return true if every value was loaded from the snapshot
+ */
+bool Config::loadSnapshot(const string &snapshotPath, const struct stat &source) {
+    ConfigSnapshotHeader header;
+    ifstream snapshotFile(snapshotPath, ios::in | ios::binary);
+
+    if(!snapshotFile.read(reinterpret_cast<char*>(&header), sizeof(header))
+       || memcmp(header.magic, SNAPSHOT_MAGIC, 4) != 0 || header.version != SNAPSHOT_VERSION
+       || header.sourceSize != (uint64_t) source.st_size || header.sourceSeconds != (int64_t) source.st_mtim.tv_sec
+       || header.sourceNanoseconds != (int64_t) source.st_mtim.tv_nsec
+       || header.intCount != SNAPSHOT_INT_COUNT || header.stringCount != SNAPSHOT_STRING_COUNT){
+        return false;
+    }
+    // values are read into a copy so a cut off snapshot does not leave half of them set
+    Config loaded = *this;
+    for(uint32_t i = 0; i < SNAPSHOT_INT_COUNT; i++){
+        int32_t value;
+        if(!snapshotFile.read(reinterpret_cast<char*>(&value), sizeof(value))){
+            return false;
+        }
+        loaded.*(snapshotInts[i]) = value;
+    }
+    for(uint32_t i = 0; i < SNAPSHOT_STRING_COUNT; i++){
+        uint32_t length;
+        if(!snapshotFile.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > header.sourceSize){
+            return false;
+        }
+        string &value = loaded.*(snapshotStrings[i]);
+        value.resize(length);
+        if(length > 0 && !snapshotFile.read(&value[0], length)){
+            return false;
+        }
+    }
+    *this = loaded;
+    return true;
+}
+/**
+ * @name saveSnapshot
+ *
+ * @details writes every value to a .confc snapshot, a snapshot that can not be written is skipped
+ *
+ * @param snapshotPath
+ *      .confc file to write
+ *
+ * @param source
+ *      file info of the .conf file
+ */
+void Config::saveSnapshot(const string &snapshotPath, const struct stat &source) const {
+    ConfigSnapshotHeader header;
+    ofstream snapshotFile(snapshotPath, ios::out | ios::binary | ios::trunc);
+
+    if(!snapshotFile){
+        return;
+    }
+    memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.version = SNAPSHOT_VERSION;
+    header.sourceSize = source.st_size;
+    header.sourceSeconds = source.st_mtim.tv_sec;
+    header.sourceNanoseconds = source.st_mtim.tv_nsec;
+    header.intCount = SNAPSHOT_INT_COUNT;
+    header.stringCount = SNAPSHOT_STRING_COUNT;
+    snapshotFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(uint32_t i = 0; i < SNAPSHOT_INT_COUNT; i++){
+        int32_t value = this->*(snapshotInts[i]);
+        snapshotFile.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    for(uint32_t i = 0; i < SNAPSHOT_STRING_COUNT; i++){
+        const string &value = this->*(snapshotStrings[i]);
+        uint32_t length = value.size();
+        snapshotFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        snapshotFile.write(value.data(), length);
+    }
+}
 //splitting function
 void Config::splitString(string in, char delimiter, string& left, string& right) {
     unsigned int pos; //position within string
@@ -387,6 +500,14 @@ int Config::getCPUQuantumNumber() const {
     return quantumNumber;
 }
 
+int Config::getProcessorCount() const {
+    return processorCount;
+}
+
+int Config::getBurstWeight() const {
+    return burstWeight;
+}
+
 string Config::getVersion() const {
     return version;
 }
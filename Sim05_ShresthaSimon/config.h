@@ -22,9 +22,42 @@
 #include <stdexcept>
 #include <chrono>
 #include <algorithm>
+#include <stdint.h>
+#include <sys/stat.h>
 
 using namespace std;
 
+class Config;
+
+//how the right side of a configuration line is stored
+enum ConfigValue
+{
+    CONFIG_STRING,
+    CONFIG_INT,
+    CONFIG_PATH
+};
+
+//one key that can appear in a configuration file
+struct ConfigKey
+{
+    const char *name;
+    ConfigValue type;
+    int Config::*intField;
+    //string field to set, for ints this gets the key name ( used for the memory units )
+    string Config::*stringField;
+    //ints are multiplied by this, paths must end with one of the extensions
+    int scale;
+    const char *extension;
+    const char *otherExtension;
+    const char *error;
+};
+
+//hash of a key name, used as case labels so two keys with the same hash do not compile
+constexpr uint32_t configHash(const char *name, uint32_t hash = 2166136261u)
+{
+    return *name == '\0' ? hash : configHash(name + 1, (hash ^ (uint8_t) *name) * 16777619u);
+}
+
 class Config
 {
 public:
@@ -50,6 +83,8 @@ public:
     int getMouseResources() const;
     int getBlockSize() const;
     int getCPUQuantumNumber() const;
+    int getProcessorCount() const;
+    int getBurstWeight() const;
     string getVersion() const;
     string getMetadataFile() const;
     string getLog() const;
@@ -59,11 +94,19 @@ public:
     string getBlockType() const;
     string getCPUSchedulingAlgorithm() const;
     //config file reader functions
-    void readConfigFile(string configFilePath);
+    void readConfigFile(string configFilePath, bool useSnapshot = false);
     void splitString(string, char, string&, string&);
     void trim(string&);
 
 private:
+    static const ConfigKey configKeys[];
+    static int Config::* const snapshotInts[];
+    static string Config::* const snapshotStrings[];
+    static const ConfigKey *findKey(const char *name, size_t length);
+    void parseConfig(const char *begin, const char *end);
+    bool loadSnapshot(const string &snapshotPath, const struct stat &source);
+    void saveSnapshot(const string &snapshotPath, const struct stat &source) const;
+
     int printerCycleTime;
     int processorCycleTime;
 	int keyboardCycleTime;
@@ -79,6 +122,10 @@ private:
 	int systemMemorySize;
 	int memoryBlockSize;
 	int quantumNumber;
+	//the key is optional, without it there is one processor
+	int processorCount = 1;
+	//percent of the last burst in an SRTF prediction, 0 leaves SRTF using the known operations
+	int burstWeight = 0;
 	string version;
 	string metadataFilePath;
 	string systemMemoryType;
@@ -0,0 +1,72 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file fifoRing.h
+ *
+ * @brief header for fixed size single producer, multiple consumer FIFO ring
+ *
+ * @details only the thread that owns the ring adds items, at the back, without a lock or a
+ *          compare and swap. Items are taken from the front with one compare and swap, by the
+ *          owner and by any other thread stealing from it, so items come out oldest first.
+ *          This is not a Chase-Lev deque, the owner has no LIFO end of its own, round robin
+ *          needs the owner to take the oldest process too. The space is set once before the
+ *          ring is used and is never moved
+ *
+ */
+#ifndef FIFORING_H
+#define FIFORING_H
+
+#include <atomic>
+#include <vector>
+using namespace std;
+
+template <typename T>
+class FifoRing {
+    public:
+        FifoRing() : top(0), bottom(0) {}
+
+        // sets how many items fit, only before any thread uses the ring
+        void setCapacity(size_t capacity){
+            this->items = vector<atomic<T> >(capacity);
+            this->top = 0;
+            this->bottom = 0;
+        }
+
+        // adds an item at the back, only the owner calls this, false if the ring is full
+        bool push(const T &item){
+            long long b = this->bottom.load(memory_order_relaxed);
+            // a top read before a pop only makes the ring look fuller than it is
+            if(b - this->top.load(memory_order_acquire) >= (long long) this->items.size()){
+                return false;
+            }
+            this->items[b % this->items.size()].store(item, memory_order_relaxed);
+            this->bottom.store(b + 1, memory_order_release);
+            return true;
+        }
+
+        // takes the item at the front, any thread can call this, false if the ring is empty
+        bool pop(T &item){
+            long long t = this->top.load(memory_order_acquire);
+            while(t < this->bottom.load(memory_order_acquire)){
+                // the slot is only reused once top has moved past it, then the swap fails
+                item = this->items[t % this->items.size()].load(memory_order_relaxed);
+                if(this->top.compare_exchange_weak(t, t + 1, memory_order_seq_cst, memory_order_acquire)){
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool empty() const {
+            return this->top.load(memory_order_acquire) >= this->bottom.load(memory_order_acquire);
+        }
+
+    private:
+        vector<atomic<T> > items;
+        // next item to take and next free slot, both only ever go up
+        atomic<long long> top;
+        atomic<long long> bottom;
+};
+
+
+#endif // !FIFORING_H
@@ -0,0 +1,185 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file fuzzTokenizer.cpp
+ *
+ * @brief tokenizer fuzz test
+ *
+ * @details feeds random text made mostly of the metadata grammar through the block tokenizer
+ *          with every version the processor supports. The delimiters it finds are checked
+ *          against a byte by byte scan, and returnInstructions and parseInstruction are
+ *          checked against the old parser they replaced, kept here as it was
+ *
+ * @note requires metadata and tokenizer class files
+ */
+#include <iostream>
+#include <string>
+#include <deque>
+#include <vector>
+#include <random>
+#include <cstdlib>
+
+#include "metadata.h"
+#include "tokenizer.h"
+using namespace std;
+
+// the old returnInstructions, one character at a time
+static bool oldReturnInstructions(string line, deque<string>& mdVector){
+    string temp;
+    for(unsigned int i = 0; i < line.size(); i++){ //iterate through entire line
+        if(line[i] == ';'){ //when a semicolon is found
+            mdVector.push_back(temp); // push everything in temp so far into vector
+            line.erase(0, i); //erase everything read so far in the line
+            i = 0; //restart iteration
+            temp.erase(); //erase temp to get new word
+            continue;
+        }else if(line[i] == '.'){ //same thing as semicolon but for a period as the last word ends with period
+            mdVector.push_back(temp);
+            line.erase(0, i);
+            i = 0;
+            return true; //return true say that we have reached the period
+        }else{
+            temp.append(string(1,line[i])); //add every iteration to temp
+        }
+
+    }
+    return false; // return false if period was not found
+
+}
+
+// the old parseInstruction, one character at a time
+static bool oldParseInstruction(string instr, string& left, string& middle, string& right){
+    int state = 0; // counter used to append to different sides and to check curly braces
+    bool seenLeft = false; // flag for left curly brace
+    bool seenRight = false; // flag for right curly brace
+    for(unsigned int i = 0; i < instr.size(); i++){
+        if(instr[i] == '{'){
+            if(!seenLeft){ //if the left curly brace has not been seen then add one to state and mark true
+                state += 1;
+                seenLeft = true;
+            }else{
+                return false;
+            }
+        }else if(instr[i] == '}'){
+            if(!seenRight){ //if the right has not been seen then add one to state and mark true
+                state += 1;
+                seenRight = true;
+            }else{
+                return false;
+            }
+        }else{
+            if(state == 0){
+                left.append(string(1,instr[i])); //append to left until left curly brace this includes white spaces
+            }else if(state == 1){
+                middle.append(string(1,instr[i])); //append until right curly brace this includes white spaces
+            }else if(state == 2){
+                right.append(string(1,instr[i])); // append everything after curly brace this includes white spaces
+            }else{
+                return false;
+            }
+        }
+    }
+    if(state != 2){
+        return false; //if duplicate curly braces are found
+    }
+    return true;
+}
+
+// random text, mostly delimiters and the characters an operation is made of
+static string randomText(mt19937 &random)
+{
+	static const string alphabet = ";;;...{{{}}}\n\n \t\rSAPIOM0123456789-beginrunhard drive";
+	size_t length = random() % 8 == 0 ? random() % 300 : random() % 70;
+	string text;
+	for (size_t i = 0; i < length; i++)
+	{
+		if (random() % 50 == 0)
+		{
+			// any byte at all, including ones with the high bit set
+			text.append(1, (char) (random() % 256));
+		}
+		else
+		{
+			text.append(1, alphabet[random() % alphabet.size()]);
+		}
+	}
+	return text;
+}
+
+// reports the text that failed and stops
+static void fail(const string &implementation, const string &check, const string &text)
+{
+	cerr << "Error, " << check << " does not match with " << implementation << " on \"" << text << "\"" << endl;
+	exit(1);
+}
+
+// checks every delimiter the tokenizer finds against a scan of each byte
+static bool sameDelimiters(const string &text)
+{
+	const char *end = text.data() + text.size();
+	Tokenizer tokenizer(text.data(), end);
+	const char *found = tokenizer.next();
+	for (const char *pos = text.data(); pos != end; pos++)
+	{
+		if (*pos == ';' || *pos == '.' || *pos == '{' || *pos == '}' || *pos == '\n')
+		{
+			if (found != pos)
+			{
+				return false;
+			}
+			found = tokenizer.next();
+		}
+	}
+	return found == end;
+}
+
+int main(int argc, char *argv[])
+{
+	long rounds = 200000;
+	if (argc == 2 && atol(argv[1]) > 0)
+	{
+		rounds = atol(argv[1]);
+	}
+	else if (argc != 1)
+	{
+		cerr << "Error! Usage: ./fuzzTokenizer [rounds]" << endl;
+		return 0;
+	}
+
+	static const char *const implementations[] = {"scalar", "sse2", "avx2"};
+	for (const char *implementation : implementations)
+	{
+		if (!Tokenizer::setImplementation(implementation))
+		{
+			cout << implementation << " not supported, skipped" << endl;
+			continue;
+		}
+		// the same texts for every version
+		mt19937 random(1);
+		for (long i = 0; i < rounds; i++)
+		{
+			string text = randomText(random);
+			if (!sameDelimiters(text))
+			{
+				fail(implementation, "Tokenizer", text);
+			}
+
+			deque<string> words, oldWords;
+			bool period = MetaData::returnInstructions(text, words);
+			if (period != oldReturnInstructions(text, oldWords) || words != oldWords)
+			{
+				fail(implementation, "returnInstructions", text);
+			}
+
+			string left, middle, right, oldLeft, oldMiddle, oldRight;
+			bool parsed = MetaData::parseInstruction(text, left, middle, right);
+			if (parsed != oldParseInstruction(text, oldLeft, oldMiddle, oldRight)
+				|| (parsed && (left != oldLeft || middle != oldMiddle || right != oldRight)))
+			{
+				fail(implementation, "parseInstruction", text);
+			}
+		}
+		cout << implementation << ": " << rounds << " texts matched" << endl;
+	}
+	return 0;
+}
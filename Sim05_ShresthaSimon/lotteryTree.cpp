@@ -0,0 +1,68 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file lotteryTree.cpp
+ *
+ * @brief implementation file for LOTTERY ticket tree class
+ *
+ * @details the tree is only used under the lock of the processor it belongs to, so nothing
+ *          here is locked
+ *
+ */
+#include <vector>
+
+#include "lotteryTree.h"
+using namespace std;
+
+LotteryTree::LotteryTree() {
+    this->ticketCount = 0;
+    this->topStep = 0;
+}
+
+/**
+ * @details: empties the tree and makes room for the slots
+ * @param capacity
+ *        most slots
+ */
+void LotteryTree::setCapacity(size_t capacity) {
+    this->sums.assign(capacity + 1, 0);
+    this->ticketCount = 0;
+    this->topStep = 1;
+    while(this->topStep * 2 <= capacity){
+        this->topStep *= 2;
+    }
+}
+
+/**
+ * @details: updates every range the slot is in
+ * @param slot
+ * @param tickets
+ */
+void LotteryTree::add(size_t slot, long long tickets) {
+    for(size_t i = slot + 1; i < this->sums.size(); i += i & (~i + 1)){
+        this->sums[i] += tickets;
+    }
+    this->ticketCount += tickets;
+}
+
+long long LotteryTree::total() const {
+    return this->ticketCount;
+}
+
+/**
+ * @details: walks down from the widest range, skipping every range that ends before the ticket
+ * @param ticket
+ *        from 0 up to one less than the total
+ * @return
+ *        slot holding the ticket
+ */
+size_t LotteryTree::draw(long long ticket) const {
+    size_t position = 0;
+    for(size_t step = this->topStep; step > 0; step /= 2){
+        if(position + step < this->sums.size() && this->sums[position + step] <= ticket){
+            position += step;
+            ticket -= this->sums[position];
+        }
+    }
+    return position;
+}
@@ -0,0 +1,40 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file lotteryTree.h
+ *
+ * @brief header for LOTTERY ticket tree class
+ *
+ * @details the tickets of every ready process are kept in a Fenwick tree indexed by a slot
+ *          for each process, so adding or taking out a process and drawing the winner of a
+ *          lottery are all O(log P)
+ *
+ */
+#ifndef LOTTERYTREE_H
+#define LOTTERYTREE_H
+
+#include <vector>
+using namespace std;
+
+class LotteryTree {
+    public:
+        LotteryTree();
+        // sets how many slots there are, every slot starts with no tickets
+        void setCapacity(size_t capacity);
+        // adds tickets to a slot, a negative count takes them out
+        void add(size_t slot, long long tickets);
+        // tickets in every slot together
+        long long total() const;
+        // finds the slot holding a ticket, tickets are numbered from 0 in slot order
+        size_t draw(long long ticket) const;
+
+    private:
+        // each entry holds the tickets of a range of slots ending at it, numbered from 1
+        vector<long long> sums;
+        long long ticketCount;
+        // highest power of two that is not past the number of slots
+        size_t topStep;
+};
+
+
+#endif // !LOTTERYTREE_H
@@ -11,18 +11,32 @@
  */
 #include <iostream>
 #include "OperatingSystem.h"
+#include "metabinary.h"
 
 using namespace std;
 
 int main(int argc, char *argv[])
 {
     //checks if an argument was passed in
-    if(argc != 2){
+    if(argc < 2){
         cerr << "Error! You must use a .conf file as an input for this application." << endl;
         return 0;
     }
+    // optional run modes after the .conf file
+    bool configSnapshot = false;
+    bool asyncIO = false;
+    for(int i = 2; i < argc; i++){
+        if(string(argv[i]) == "--config-cache"){
+            configSnapshot = true;
+        }else if(string(argv[i]) == "--async-io"){
+            asyncIO = true;
+        }else{
+            cerr << "Error! Unknown option " << argv[i] << endl;
+            return 0;
+        }
+    }
     // only run if argument is passed in
-	if (argc == 2)
+	if (argc >= 2)
 	{
 		typedef std::chrono::high_resolution_clock Time;
 		//config object
@@ -41,9 +55,9 @@ int main(int argc, char *argv[])
 		OperatingSystem OpSystem(configPtr, metaDataPtr, resourcePtr);
 		//operating system pointer
 		OperatingSystem *procPtr = &OpSystem;
+		OpSystem.asyncIO = asyncIO;
 		string configFileName,
-			metadataFileName,
-			metadataData;
+			metadataFileName;
         //set quantity for each resources
 		config.setHarddriveResources("1");
 		config.setKeyboardResources("1");
@@ -59,12 +73,17 @@ int main(int argc, char *argv[])
 		OpSystem.setProcessorState("START");
         // parse through config file
         configFileName = argv[1];
-        config.readConfigFile(configFileName);
+        config.readConfigFile(configFileName, configSnapshot);
         //parse through metadata file
 		metadataFileName = config.getMetadataFile();
-		metadataData = metaData.loadMetadataFile(metadataFileName);
-		metaData.readMetadataFile(metadataData);
-		metaData.getMetadataComponents(metaData.getmetaVector());
+		if (MetaBinary::isBinaryPath(metadataFileName))
+		{
+			metaData.mapBinaryFile(metadataFileName);
+		}
+		else
+		{
+			metaData.mapMetadataFile(metadataFileName);
+		}
 
 		OpSystem.setProcessorState("READY");
         // initialize resources depending on what is read from config file
@@ -72,7 +91,7 @@ int main(int argc, char *argv[])
 
 		OpSystem.setProcessorState("RUNNING");
         // creates threads and runs them
-		OpSystem.threadUsage(metaData.getmetaVector(), OpSystem);
+		OpSystem.threadUsage(metaData.getOperations(), OpSystem);
 
 		OpSystem.setProcessorState("WAITING");
 		OpSystem.setProcessorState("READY");
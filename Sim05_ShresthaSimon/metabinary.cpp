@@ -0,0 +1,298 @@
+/**
+ * @file metabinary.cpp
+ *
+ * @brief implementation file for compiled metadata file class
+ *
+ * @details writes and maps .mdb files
+ *
+ */
+#include "metabinary.h"
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+MetaBinary::MetaBinary()
+{
+	mappedFile = NULL;
+	mappedSize = 0;
+	header = NULL;
+	descriptors = NULL;
+	operations = NULL;
+	processes = NULL;
+	timings = NULL;
+}
+//unmaps the file
+MetaBinary::~MetaBinary()
+{
+	if (mappedFile != NULL)
+	{
+		munmap(mappedFile, mappedSize);
+	}
+}
+/**
+ * @name isBinaryPath
+ *
+ * @details checks if the path ends with .mdb
+ *
+ * @param filePath
+ * @return
+ */
+bool MetaBinary::isBinaryPath(const string &filePath)
+{
+	return filePath.size() > 4 && filePath.compare(filePath.size() - 4, 4, ".mdb") == 0;
+}
+/**
+ * @name compile
+ *
+ * @details writes the operations into a .mdb file. Descriptors are stored once in the
+ *          descriptor table and the processes are indexed from each A{begin} up to
+ *          the next finish. A{begin} operations with a deadline go in the timing table.
+ *          Records point into the mapped metadata file, their descriptors are compared
+ *          in place against the table so no string is made for each one
+ *
+ * @param operations
+ *      every operation read from the .mdf file
+ * @param outputPath
+ *      .mdb file to write
+ */
+void MetaBinary::compile(const vector<MetaRecord> &operations, string outputPath)
+{
+	vector<string> descriptorTable;
+	vector<MdbOperation> packed;
+	vector<MdbProcess> index;
+	vector<MdbTiming> timings;
+	MdbHeader header;
+	uint64_t fileSize;
+	uint32_t beginIndex = 0xFFFF, finishIndex = 0xFFFF;
+
+	packed.reserve(operations.size());
+	//pack every operation and intern its descriptor, there are only a few descriptors
+	for (auto current = operations.begin(); current != operations.end(); ++current)
+	{
+		uint32_t found = 0;
+		while (found < descriptorTable.size()
+			   && (descriptorTable[found].size() != current->descriptorLength
+				   || memcmp(descriptorTable[found].data(), current->descriptor, current->descriptorLength) != 0))
+		{
+			found++;
+		}
+		if (found == descriptorTable.size())
+		{
+			if (current->descriptorLength >= (unsigned int) MDB_DESCRIPTOR_SIZE || descriptorTable.size() >= 0xFFFF)
+			{
+				cerr << "Error! Descriptor " << string(current->descriptor, current->descriptorLength) << " can not be compiled" << endl;
+				exit(0);
+			}
+			descriptorTable.push_back(string(current->descriptor, current->descriptorLength));
+			if (descriptorTable.back() == "begin")
+				beginIndex = found;
+			else if (descriptorTable.back() == "finish")
+				finishIndex = found;
+		}
+		MdbOperation op;
+		op.code = current->code;
+		op.reserved = 0;
+		op.descriptor = found;
+		op.cycles = current->cycles;
+		if (current->deadline > 0)
+		{
+			MdbTiming timing;
+			timing.operation = packed.size();
+			timing.deadline = current->deadline;
+			timing.period = current->period;
+			timings.push_back(timing);
+		}
+		packed.push_back(op);
+	}
+
+	//index every A{begin} ... A{finish} block
+	for (uint64_t i = 0; i < packed.size(); i++)
+	{
+		if (packed[i].code == 'A' && packed[i].descriptor == beginIndex)
+		{
+			MdbProcess p;
+			p.firstOperation = i + 1;
+			p.operationCount = 0;
+			p.ioCount = 0;
+			p.taskCount = 0;
+			for (uint64_t j = i + 1; j < packed.size() && packed[j].descriptor != finishIndex; j++)
+			{
+				if (packed[j].code == 'I' || packed[j].code == 'O')
+				{
+					p.ioCount++;
+				}
+				p.taskCount++;
+				p.operationCount++;
+			}
+			index.push_back(p);
+		}
+	}
+
+	//every offset is 32 bits and operations keep their timing in 16 bits
+	fileSize = sizeof(MdbHeader) + (uint64_t) descriptorTable.size() * MDB_DESCRIPTOR_SIZE
+			   + (uint64_t) packed.size() * sizeof(MdbOperation) + (uint64_t) index.size() * sizeof(MdbProcess)
+			   + (uint64_t) timings.size() * sizeof(MdbTiming);
+	if (fileSize > UINT32_MAX)
+	{
+		cerr << "Error! Meta Data File is too large to be compiled, a .mdb file has to be under 4 GiB" << endl;
+		exit(0);
+	}
+	if (timings.size() > 0xFFFF)
+	{
+		cerr << "Error! Meta Data File has too many processes with a deadline to be compiled" << endl;
+		exit(0);
+	}
+
+	memcpy(header.magic, MDB_MAGIC, 4);
+	header.version = MDB_VERSION;
+	header.descriptorCount = descriptorTable.size();
+	header.operationCount = packed.size();
+	header.processCount = index.size();
+	header.descriptorOffset = sizeof(MdbHeader);
+	header.operationOffset = header.descriptorOffset + header.descriptorCount * MDB_DESCRIPTOR_SIZE;
+	header.processOffset = header.operationOffset + header.operationCount * sizeof(MdbOperation);
+	header.timingCount = timings.size();
+	header.timingOffset = header.processOffset + header.processCount * sizeof(MdbProcess);
+
+	ofstream outFile(outputPath, ios::out | ios::binary | ios::trunc);
+	if (!outFile)
+	{
+		cerr << "Error! Can't write " << outputPath << endl;
+		exit(0);
+	}
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (auto &descriptor : descriptorTable)
+	{
+		char entry[MDB_DESCRIPTOR_SIZE] = {0};
+		memcpy(entry, descriptor.c_str(), descriptor.size());
+		outFile.write(entry, MDB_DESCRIPTOR_SIZE);
+	}
+	outFile.write(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(MdbOperation));
+	outFile.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(MdbProcess));
+	outFile.write(reinterpret_cast<const char*>(timings.data()), timings.size() * sizeof(MdbTiming));
+	outFile.close();
+}
+/**
+ * @name open
+ *
+ * @details maps a .mdb file and checks that the tables fit inside of it
+ *
+ * @param filePath
+ *      .mdb file to map
+ */
+void MetaBinary::open(string filePath)
+{
+	struct stat fileInfo;
+	int fd = ::open(filePath.c_str(), O_RDONLY);
+
+	if (fd < 0 || fstat(fd, &fileInfo) != 0 || fileInfo.st_size < (off_t) sizeof(MdbHeader))
+	{
+		cerr << "Error! Compiled Meta Data File can not be read" << endl;
+		exit(0);
+	}
+	mappedSize = fileInfo.st_size;
+	void *mapped = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED)
+	{
+		cerr << "Error! Compiled Meta Data File can not be read" << endl;
+		exit(0);
+	}
+	mappedFile = static_cast<char*>(mapped);
+	header = reinterpret_cast<const MdbHeader*>(mappedFile);
+
+	//check that this is a compiled file and that every table is inside the file
+	if (memcmp(header->magic, MDB_MAGIC, 4) != 0 || header->version != MDB_VERSION
+		|| header->descriptorOffset + (uint64_t) header->descriptorCount * MDB_DESCRIPTOR_SIZE > mappedSize
+		|| header->operationOffset + (uint64_t) header->operationCount * sizeof(MdbOperation) > mappedSize
+		|| header->processOffset + (uint64_t) header->processCount * sizeof(MdbProcess) > mappedSize
+		|| header->timingOffset + (uint64_t) header->timingCount * sizeof(MdbTiming) > mappedSize
+		|| header->timingCount > 0xFFFF)
+	{
+		cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+		exit(0);
+	}
+	descriptors = mappedFile + header->descriptorOffset;
+	operations = reinterpret_cast<const MdbOperation*>(mappedFile + header->operationOffset);
+	processes = reinterpret_cast<const MdbProcess*>(mappedFile + header->processOffset);
+	timings = reinterpret_cast<const MdbTiming*>(mappedFile + header->timingOffset);
+
+	//every descriptor has to end inside of its entry
+	for (uint32_t i = 0; i < header->descriptorCount; i++)
+	{
+		if (descriptors[i * MDB_DESCRIPTOR_SIZE + MDB_DESCRIPTOR_SIZE - 1] != '\0')
+		{
+			cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+			exit(0);
+		}
+	}
+	//every operation has to point at a descriptor in the table
+	for (uint32_t i = 0; i < header->operationCount; i++)
+	{
+		if (operations[i].descriptor >= header->descriptorCount)
+		{
+			cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+			exit(0);
+		}
+	}
+	for (uint32_t i = 0; i < header->processCount; i++)
+	{
+		if ((uint64_t) processes[i].firstOperation + processes[i].operationCount > header->operationCount)
+		{
+			cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+			exit(0);
+		}
+	}
+	//every timing has to point at an operation
+	for (uint32_t i = 0; i < header->timingCount; i++)
+	{
+		if (timings[i].operation >= header->operationCount || timings[i].deadline <= 0)
+		{
+			cerr << "Error! Compiled Meta Data File is not formatted correctly" << endl;
+			exit(0);
+		}
+	}
+}
+//getter functions
+uint32_t MetaBinary::getDescriptorCount() const
+{
+	return header->descriptorCount;
+}
+
+uint32_t MetaBinary::getOperationCount() const
+{
+	return header->operationCount;
+}
+
+uint32_t MetaBinary::getProcessCount() const
+{
+	return header->processCount;
+}
+
+uint32_t MetaBinary::getTimingCount() const
+{
+	return header->timingCount;
+}
+
+const MdbOperation &MetaBinary::getOperation(uint32_t i) const
+{
+	return operations[i];
+}
+
+const MdbProcess &MetaBinary::getProcess(uint32_t i) const
+{
+	return processes[i];
+}
+
+const MdbTiming &MetaBinary::getTiming(uint32_t i) const
+{
+	return timings[i];
+}
+
+const char *MetaBinary::getDescriptor(uint16_t i) const
+{
+	return descriptors + i * MDB_DESCRIPTOR_SIZE;
+}
@@ -9,6 +9,14 @@
  */
 
 #include "metadata.h"
+#include "metabinary.h"
+#include "tokenizer.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <cstring>
 using namespace std;
 // Constructor Implementation/////////////////////////////////////////////////////////////////
 //
@@ -19,7 +27,7 @@ MetaData::MetaData() {
 // Destructor Implementation//////////////////////////////////////////////////////////////
 //
 MetaData::~MetaData() {
-
+    unmapMetadataFile();
 }
 //
 // Parameterized Constructor Implementation///////////////////////////////////////////////
@@ -30,6 +38,32 @@ MetaData::MetaData(char code, string descriptor, int cycles) {
     this->cycles = cycles;
 }
 //
+// Copy Constructor Implementation////////////////////////////////////////////////////////
+//
+MetaData::MetaData(const MetaData &other) {
+    *this = other;
+}
+//
+// Copy Assignment Implementation/////////////////////////////////////////////////////////
+//
+// the records point into the mapped file of the original so only the parsed operations
+// are copied, the copy never maps or unmaps anything of the original
+MetaData &MetaData::operator=(const MetaData &other) {
+    if(this != &other){
+        unmapMetadataFile();
+        this->code = other.code;
+        this->descriptor = other.descriptor;
+        this->cycles = other.cycles;
+        this->time = other.time;
+        this->startTime = other.startTime;
+        this->metaVector = other.metaVector;
+        this->operations = other.operations;
+        this->processes = other.processes;
+        this->timings = other.timings;
+    }
+    return *this;
+}
+//
 // Printing MetaData info implementation
 void MetaData::printMetaData(ostream& out) {
     out << code << "{"<< descriptor << "}" << cycles;
@@ -131,23 +165,17 @@ void MetaData::Trim(string& str){
  *        vector used to store the words created from parsing each line
  */
 bool MetaData::returnInstructions(string line, deque<string>& mdVector){
-    string temp;
-    for(unsigned int i = 0; i < line.size(); i++){ //iterate through entire line
-        if(line[i] == ';'){ //when a semicolon is found
-            mdVector.push_back(temp); // push everything in temp so far into vector
-            line.erase(0, i); //erase everything read so far in the line
-            i = 0; //restart iteration
-            temp.erase(); //erase temp to get new word
-            continue;
-        }else if(line[i] == '.'){ //same thing as semicolon but for a period as the last word ends with period
-            mdVector.push_back(temp);
-            line.erase(0, i);
-            i = 0;
+    const char *wordStart = line.data(); //start of the word being read
+    const char *lineEnd = line.data() + line.size();
+    Tokenizer tokenizer(wordStart, lineEnd);
+    for(const char *pos = tokenizer.next(); pos != lineEnd; pos = tokenizer.next()){ //jump between delimiters
+        if(*pos == ';'){ //when a semicolon is found
+            mdVector.push_back(string(wordStart, pos)); // push everything since the last word into vector
+            wordStart = pos + 1; //next word starts after the semicolon
+        }else if(*pos == '.'){ //same thing as semicolon but for a period as the last word ends with period
+            mdVector.push_back(string(wordStart, pos));
             return true; //return true say that we have reached the period
-        }else{
-            temp.append(string(1,line[i])); //add every iteration to temp
         }
-
     }
     return false; // return false if period was not found
 
@@ -174,39 +202,36 @@ bool MetaData::returnInstructions(string line, deque<string>& mdVector){
  *        right of the curly braces = cycles
  */
 bool MetaData::parseInstruction(string instr, string& left, string& middle, string& right){
+    const char *begin = instr.data();
+    const char *end = instr.data() + instr.size();
+    const char *braces[2]; // position of the two curly braces
     int state = 0; // counter used to append to different sides and to check curly braces
     bool seenLeft = false; // flag for left curly brace
     bool seenRight = false; // flag for right curly brace
-    for(unsigned int i = 0; i < instr.size(); i++){
-        if(instr[i] == '{'){
-            if(!seenLeft){ //if the left curly brace has not been seen then add one to state and mark true
-                state += 1;
-                seenLeft = true;
-            }else{
+    Tokenizer tokenizer(begin, end);
+    for(const char *pos = tokenizer.next(); pos != end; pos = tokenizer.next()){
+        if(*pos == '{'){
+            if(seenLeft){ //a second left curly brace
                 return false;
             }
-        }else if(instr[i] == '}'){
-            if(!seenRight){ //if the right has not been seen then add one to state and mark true
-                state += 1;
-                seenRight = true;
-            }else{
+            seenLeft = true;
+        }else if(*pos == '}'){
+            if(seenRight){ //a second right curly brace
                 return false;
             }
+            seenRight = true;
         }else{
-            if(state == 0){
-                left.append(string(1,instr[i])); //append to left until left curly brace this includes white spaces
-            }else if(state == 1){
-                middle.append(string(1,instr[i])); //append until right curly brace this includes white spaces
-            }else if(state == 2){
-                right.append(string(1,instr[i])); // append everything after curly brace this includes white spaces
-            }else{
-                return false;
-            }
+            continue;
         }
+        braces[state] = pos;
+        state += 1;
     }
     if(state != 2){
         return false; //if duplicate curly braces are found
     }
+    left.append(begin, braces[0]); //everything before the first curly brace this includes white spaces
+    middle.append(braces[0] + 1, braces[1]); //everything between the curly braces this includes white spaces
+    right.append(braces[1] + 1, end); // everything after the second curly brace this includes white spaces
     return true;
 }
 /**
@@ -430,5 +455,501 @@ void MetaData::getMetadataComponents(vector<string> vector)
     // set the vector
 	setmetaVector(vector);
 }
+//files smaller than this per thread are not worth splitting up
+static const size_t PARSE_CHUNK_MIN = 1 << 20;
+int MetaData::parseThreads = 0;
+//most processes with a deadline in one file, the index has to fit in an operation
+static const size_t MAX_TIMINGS = 0xFFFF;
+
+//result of parsing one chunk of the metadata file
+enum ParseStatus
+{
+	PARSE_OK,
+	PARSE_PERIOD,
+	PARSE_ERROR
+};
+
+//work handed to each parsing thread
+struct ParseChunk
+{
+	const char *begin;
+	const char *end;
+	vector<MetaRecord> records;
+	ParseStatus status;
+	const char *error;
+	unsigned int timingCount; //records with a deadline
+	//where this chunk starts in the merged records, operations and timings
+	MetaRecord *recordsOut;
+	Operation *operationsOut;
+	ProcessTiming *timingsOut;
+	unsigned int firstTiming;
+	//first record the pack worker could not convert, the main thread reports it
+	string packError;
+	const char *packErrorAt;
+};
+/**
+ * @name readNumber
+ *
+ * @details reads the digits at pos and any spaces after them
+ *
+ * @param pos
+ *      moved past the number
+ * @param end
+ * @param value
+ * @return
+ *      false if there are no digits
+ */
+static bool readNumber(const char *&pos, const char *end, int &value)
+{
+	bool seen = false;
+
+	value = 0;
+	while (pos < end && *pos >= '0' && *pos <= '9')
+	{
+		value = (value * 10) + (*pos - '0');
+		seen = true;
+		pos++;
+	}
+	while (pos < end && *pos == ' ')
+		pos++;
+	return seen;
+}
+/**
+ * @name parseChunk
+ *
+ * @details tokenizes the operations between begin and end, stops at the period
+ *          errors are saved instead of printed so only the first one in the file is reported
+ *
+ * @param chunk
+ *      chunk to parse, records and status are filled in
+ */
+static void parseChunk(ParseChunk &chunk)
+{
+	const char *pos = chunk.begin, *end = chunk.end, *descriptorEnd, *delimiter;
+	MetaRecord record;
+	bool negative, seenCycle;
+
+	chunk.status = PARSE_OK;
+	chunk.timingCount = 0;
+	chunk.records.reserve((end - pos) / 16);
+	//the tokenizer jumps between the ; . { } and new lines in the chunk
+	Tokenizer tokenizer(pos, end);
+	delimiter = tokenizer.next();
+	//read operations until the period is reached
+	while (pos < end)
+	{
+		//skip whitespace between operations
+		while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t'))
+			pos++;
+		if (pos >= end)
+			break;
+		//the code is the character in front of the curly brace
+		record.code = *pos++;
+		while (pos < end && *pos == ' ')
+			pos++;
+		if (pos >= end || *pos != '{')
+		{
+			chunk.status = PARSE_ERROR;
+			chunk.error = "Error, metafile file not read correctly";
+			return;
+		}
+		//the descriptor is everything between the curly braces
+		record.descriptor = ++pos;
+		while (delimiter < pos)
+			delimiter = tokenizer.next();
+		while (delimiter != end && *delimiter != '}' && *delimiter != ';')
+			delimiter = tokenizer.next();
+		pos = delimiter;
+		if (pos >= end || *pos != '}')
+		{
+			chunk.status = PARSE_ERROR;
+			chunk.error = "Error, metafile file not read correctly";
+			return;
+		}
+		descriptorEnd = pos++;
+		record.descriptorLength = descriptorEnd - record.descriptor;
+		//the cycle is everything after the curly brace up until ; or .
+		record.cycles = 0;
+		negative = false;
+		seenCycle = false;
+		while (pos < end && *pos == ' ')
+			pos++;
+		if (pos < end && *pos == '-')
+		{
+			negative = true;
+			pos++;
+		}
+		while (pos < end && *pos >= '0' && *pos <= '9')
+		{
+			record.cycles = (record.cycles * 10) + (*pos - '0');
+			seenCycle = true;
+			pos++;
+		}
+		while (pos < end && *pos == ' ')
+			pos++;
+		// if empty or negative cycle number
+		if (!seenCycle)
+		{
+			chunk.status = PARSE_ERROR;
+			chunk.error = "Error, cycle number not found";
+			return;
+		}
+		if (negative)
+		{
+			chunk.status = PARSE_ERROR;
+			chunk.error = "Error, incorrect cycle number";
+			return;
+		}
+		//A{begin} can be followed by a deadline and a period, A{begin}0,300,500
+		record.deadline = 0;
+		record.period = 0;
+		if (pos < end && *pos == ',')
+		{
+			if (record.code != 'A' || record.descriptorLength != 5 || memcmp(record.descriptor, "begin", 5) != 0)
+			{
+				chunk.status = PARSE_ERROR;
+				chunk.error = "Error, only A{begin} takes a deadline and period";
+				return;
+			}
+			pos++;
+			while (pos < end && *pos == ' ')
+				pos++;
+			if (!readNumber(pos, end, record.deadline) || record.deadline == 0)
+			{
+				chunk.status = PARSE_ERROR;
+				chunk.error = "Error, incorrect deadline or period";
+				return;
+			}
+			if (pos < end && *pos == ',')
+			{
+				pos++;
+				while (pos < end && *pos == ' ')
+					pos++;
+				if (!readNumber(pos, end, record.period))
+				{
+					chunk.status = PARSE_ERROR;
+					chunk.error = "Error, incorrect deadline or period";
+					return;
+				}
+			}
+			chunk.timingCount++;
+		}
+		if (pos >= end || (*pos != ';' && *pos != '.'))
+		{
+			chunk.status = PARSE_ERROR;
+			chunk.error = "Error, metafile file not read correctly";
+			return;
+		}
+		chunk.records.push_back(record);
+		if (*pos++ == '.')
+		{
+			chunk.status = PARSE_PERIOD;
+			return;
+		}
+	}
+}
+//thread function that parses one chunk
+static void *parseWorker(void *chunk)
+{
+	parseChunk(*static_cast<ParseChunk*>(chunk));
+	return NULL;
+}
+//thread function that copies one chunk into the merged vectors and packs its operations
+//a bad code or descriptor is saved with its byte offset, exiting here would race the other workers
+static void *packWorker(void *arg)
+{
+	ParseChunk *chunk = static_cast<ParseChunk*>(arg);
+	unsigned int timed = 0;
+	OpCode code;
+	Device device;
 
+	chunk->packError.clear();
+	for (unsigned int i = 0; i < chunk->records.size(); i++)
+	{
+		const MetaRecord &record = chunk->records[i];
+		chunk->recordsOut[i] = record;
+		if (!readOpCode(record.code, code))
+		{
+			chunk->packError = "Error, invalid metadata code";
+			chunk->packErrorAt = record.descriptor;
+			return NULL;
+		}
+		if (!readDevice(record.descriptor, record.descriptorLength, device))
+		{
+			chunk->packError = "Error, invalid metadata descriptor " + string(record.descriptor, record.descriptorLength);
+			chunk->packErrorAt = record.descriptor;
+			return NULL;
+		}
+		chunk->operationsOut[i] = makeOperation(code, device, record.cycles);
+		if (record.deadline > 0)
+		{
+			chunk->timingsOut[timed].deadline = record.deadline;
+			chunk->timingsOut[timed].period = record.period;
+			chunk->operationsOut[i].timing = chunk->firstTiming + ++timed;
+		}
+	}
+	return NULL;
+}
+//runs the worker on every chunk, the last chunk is run on the calling thread
+static void runChunks(vector<ParseChunk> &chunks, unsigned int count, void *(*worker)(void*))
+{
+	vector<pthread_t> threads(count);
 
+	for (unsigned int i = 0; i + 1 < count; i++)
+		pthread_create(&threads[i], NULL, worker, &chunks[i]);
+	worker(&chunks[count - 1]);
+	for (unsigned int i = 0; i + 1 < count; i++)
+		pthread_join(threads[i], NULL);
+}
+/**
+ * @name mapMetadataFile
+ *
+ * @details maps the metadata file into memory and tokenizes it
+ *          each operation is stored as a record pointing back into the mapped file
+ *          so no substrings are copied while parsing. Large files are split into one
+ *          chunk per core, each chunk ends right after a ; so the chunks are parsed on
+ *          their own threads and joined back together in file order. Once the operations
+ *          are packed the file is unmapped unless the records are kept for the compiler
+ *
+ * @param metadataFile
+ *      path of the .mdf file
+ * @param keepRecords
+ *      keeps the file mapped so getRecords can be used until unmapMetadataFile
+ */
+void MetaData::mapMetadataFile(string metadataFile, bool keepRecords)
+{
+	struct stat fileInfo;
+	int fd;
+	const char *pos, *end;
+	long cores;
+	unsigned int chunkCount, used;
+	size_t total, timingTotal;
+	vector<ParseChunk> chunks;
+
+	unmapMetadataFile();
+	records.clear();
+	//open and map the file
+	fd = open(metadataFile.c_str(), O_RDONLY);
+	if (fd < 0 || fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0)
+	{
+		cerr << "Error, metafile file not read correctly" << endl;
+		exit(0);
+	}
+	mappedSize = fileInfo.st_size;
+	mappedFile = static_cast<char*>(mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0));
+	close(fd);
+	if (mappedFile == MAP_FAILED)
+	{
+		mappedFile = NULL;
+		mappedSize = 0;
+		cerr << "Error, metafile file not read correctly" << endl;
+		exit(0);
+	}
+
+	pos = mappedFile;
+	end = mappedFile + mappedSize;
+	//skip the start line
+	while (pos < end && *pos != '\n')
+		pos++;
+	//one chunk per core as long as every chunk is big enough to be worth a thread
+	cores = parseThreads > 0 ? parseThreads : sysconf(_SC_NPROCESSORS_ONLN);
+	chunkCount = (end - pos) / PARSE_CHUNK_MIN;
+	if (cores > 0 && chunkCount > (unsigned int) cores)
+		chunkCount = cores;
+	if (chunkCount == 0)
+		chunkCount = 1;
+	madvise(mappedFile, mappedSize, chunkCount == 1 ? MADV_SEQUENTIAL : MADV_WILLNEED);
+	//move every split point forward to just after the next ;
+	chunks.resize(chunkCount);
+	for (unsigned int i = 0; i < chunkCount; i++)
+	{
+		chunks[i].begin = (i == 0) ? pos : chunks[i - 1].end;
+		chunks[i].end = end;
+		if (i + 1 < chunkCount)
+		{
+			const char *split = pos + (end - pos) / chunkCount * (i + 1);
+			if (split < chunks[i].begin)
+				split = chunks[i].begin;
+			split = static_cast<const char*>(memchr(split, ';', end - split));
+			if (split != NULL)
+				chunks[i].end = split + 1;
+		}
+	}
+	runChunks(chunks, chunkCount, parseWorker);
+
+	//chunks are used in file order up to the one holding the period, the first error wins
+	total = 0;
+	timingTotal = 0;
+	used = 0;
+	while (used < chunkCount)
+	{
+		if (chunks[used].status == PARSE_ERROR)
+		{
+			cerr << chunks[used].error << endl;
+			exit(0);
+		}
+		total += chunks[used].records.size();
+		timingTotal += chunks[used].timingCount;
+		if (chunks[used++].status == PARSE_PERIOD)
+			break;
+	}
+	if (used == 0 || chunks[used - 1].status != PARSE_PERIOD)
+	{
+		cerr << "Error, metafile file not read correctly" << endl;
+		exit(0);
+	}
+	if (timingTotal > MAX_TIMINGS)
+	{
+		cerr << "Error, too many processes with a deadline" << endl;
+		exit(0);
+	}
+	//prefix sums give each chunk its place in the merged vectors
+	records.resize(total);
+	operations.clear();
+	operations.resize(total);
+	timings.clear();
+	timings.resize(timingTotal);
+	total = 0;
+	timingTotal = 0;
+	for (unsigned int i = 0; i < used; i++)
+	{
+		chunks[i].recordsOut = records.data() + total;
+		chunks[i].operationsOut = operations.data() + total;
+		chunks[i].timingsOut = timings.data() + timingTotal;
+		chunks[i].firstTiming = timingTotal;
+		total += chunks[i].records.size();
+		timingTotal += chunks[i].timingCount;
+	}
+	runChunks(chunks, used, packWorker);
+	//every worker is joined, the bad record nearest the start of the file is reported
+	const ParseChunk *firstError = NULL;
+	for (unsigned int i = 0; i < used; i++)
+	{
+		if (!chunks[i].packError.empty() && (firstError == NULL || chunks[i].packErrorAt < firstError->packErrorAt))
+			firstError = &chunks[i];
+	}
+	if (firstError != NULL)
+	{
+		cerr << firstError->packError << endl;
+		exit(0);
+	}
+	indexProcesses();
+	if (!keepRecords)
+		unmapMetadataFile();
+}
+/**
+ * @name mapBinaryFile
+ *
+ * @details maps a compiled .mdb file, the operations are already parsed so they are
+ *          only copied into the metadata vector
+ *
+ * @param binaryFile
+ *      path of the .mdb file
+ */
+void MetaData::mapBinaryFile(string binaryFile)
+{
+	MetaBinary metaBinary;
+
+	vector<Device> devices;
+
+	metaBinary.open(binaryFile);
+	//the descriptor table is converted once, operations only look up their entry
+	for (uint32_t i = 0; i < metaBinary.getDescriptorCount(); i++)
+	{
+		const char *descriptor = metaBinary.getDescriptor(i);
+		devices.push_back(toDevice(descriptor, strlen(descriptor)));
+	}
+	operations.clear();
+	operations.reserve(metaBinary.getOperationCount());
+	for (uint32_t i = 0; i < metaBinary.getOperationCount(); i++)
+	{
+		const MdbOperation &op = metaBinary.getOperation(i);
+		operations.push_back(makeOperation(toOpCode(op.code), devices[op.descriptor], op.cycles));
+	}
+	timings.clear();
+	for (uint32_t i = 0; i < metaBinary.getTimingCount(); i++)
+	{
+		const MdbTiming &timing = metaBinary.getTiming(i);
+		ProcessTiming processTiming;
+		processTiming.deadline = timing.deadline;
+		processTiming.period = timing.period;
+		timings.push_back(processTiming);
+		operations[timing.operation].timing = timings.size();
+	}
+	indexProcesses();
+}
+/**
+ * @name setParseThreads
+ *
+ * @details limits how many threads later calls to mapMetadataFile split a file across
+ *
+ * @param threads
+ *      0 to use one thread per core
+ */
+void MetaData::setParseThreads(int threads)
+{
+	parseThreads = threads;
+}
+/**
+ * @name indexProcesses
+ *
+ * @details pairs every A{begin} with the A{finish} after it in one pass over the operations
+ *          each process is stored as the operations between the two
+ */
+void MetaData::indexProcesses()
+{
+	bool inProcess = false;
+	ProcessSpan span;
+
+	processes.clear();
+	for (unsigned int i = 0; i < operations.size(); i++)
+	{
+		if (operations[i].code == OP_APPLICATION && operations[i].device == DEV_BEGIN)
+		{
+			span.firstOperation = i + 1;
+			inProcess = true;
+		}
+		else if (inProcess && operations[i].device == DEV_FINISH)
+		{
+			span.operationCount = i - span.firstOperation;
+			processes.push_back(span);
+			inProcess = false;
+		}
+	}
+}
+/**
+ * @name unmapMetadataFile
+ *
+ * @details releases the mapped metadata file, records can no longer be used afterwards
+ */
+void MetaData::unmapMetadataFile()
+{
+	if (mappedFile != NULL)
+	{
+		munmap(mappedFile, mappedSize);
+		mappedFile = NULL;
+		mappedSize = 0;
+	}
+	records.clear();
+}
+//
+void MetaData::setOperations(const vector<Operation> &ops)
+{
+    operations = ops;
+}
+//
+const vector<Operation> &MetaData::getOperations() const {
+    return operations;
+}
+//
+const vector<MetaRecord> &MetaData::getRecords() const {
+    return records;
+}
+//
+const vector<ProcessSpan> &MetaData::getProcesses() const {
+    return processes;
+}
+//timing is the index + 1 kept in the operation
+const ProcessTiming &MetaData::getTiming(uint16_t timing) const {
+    return timings[timing - 1];
+}
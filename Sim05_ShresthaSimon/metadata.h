@@ -12,6 +12,7 @@
 #define METADATA_H
 
 #include "config.h"
+#include "operation.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -27,6 +28,32 @@
 
 using namespace std;
 
+//single operation tokenized straight out of the mapped metadata file
+struct MetaRecord
+{
+    char code;
+    const char *descriptor;
+    unsigned int descriptorLength;
+    int cycles;
+    //only A{begin} has these, 0 if it does not
+    int deadline;
+    int period;
+};
+
+//deadline and period in msec of a process from A{begin}cycles,deadline,period
+struct ProcessTiming
+{
+    int deadline; //how long after it arrives the process has to be done
+    int period; //how often the process comes back, 0 if it does not
+};
+
+//one A{begin} ... A{finish} block, firstOperation is the operation after A{begin}
+struct ProcessSpan
+{
+    unsigned int firstOperation;
+    unsigned int operationCount;
+};
+
 class MetaData
 {
 public:
@@ -35,11 +62,20 @@ public:
     virtual ~MetaData();
     //Parameterized Constructor
     MetaData(char code, string descriptor, int cycles);
+    //copies leave the mapped file and its records with the original
+    MetaData(const MetaData &other);
+    MetaData &operator=(const MetaData &other);
 
     //functions to parse through metadata file
     string loadMetadataFile(string metadataFile);
     void readMetadataFile(string metadataFile);
     void getMetadataComponents(vector<string> vector);
+    void mapMetadataFile(string metadataFile, bool keepRecords = false);
+    void mapBinaryFile(string binaryFile);
+    void unmapMetadataFile();
+    static void setParseThreads(int threads);
+    void indexProcesses();
+    const vector<MetaRecord> &getRecords() const;
     static void readMetaFile(string, deque<MetaData>&);
     static bool returnInstructions(string, deque<string>& );
     static bool parseInstruction(string , string& , string& , string& );
@@ -68,6 +104,11 @@ public:
     void setmetaVector(vector<string> mVect);
 
     vector<string> getmetaVector() const;
+
+    void setOperations(const vector<Operation> &ops);
+    const vector<Operation> &getOperations() const;
+    const vector<ProcessSpan> &getProcesses() const;
+    const ProcessTiming &getTiming(uint16_t timing) const;
 private:
     char code;
     string descriptor;
@@ -75,6 +116,14 @@ private:
     double time;
     double startTime;
 	vector<string> metaVector;
+	vector<MetaRecord> records;
+	vector<Operation> operations;
+	vector<ProcessSpan> processes;
+	vector<ProcessTiming> timings;
+	char *mappedFile = NULL;
+	size_t mappedSize = 0;
+	//most threads mapMetadataFile parses with, 0 for one per core
+	static int parseThreads;
 
 };
 
@@ -0,0 +1,142 @@
+/**
+ * @file operation.cpp
+ *
+ * @brief implementation file for the packed operation record
+ *
+ */
+#include "operation.h"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+//descriptor text for each device, in the same order as the enum
+static const char *const deviceNames[DEV_COUNT] = {
+    "begin", "finish", "run", "hard drive", "keyboard", "mouse",
+    "monitor", "printer", "block", "allocate"
+};
+/**
+ * @name readOpCode
+ *
+ * @details converts a metadata code letter into an opcode without exiting,
+ *          used by the loader threads that have to report errors afterwards
+ *
+ * @param code
+ * @param opCode
+ *      set when the code is known
+ * @return
+ *      false if the code is not a metadata code
+ */
+bool readOpCode(char code, OpCode &opCode)
+{
+    switch (code)
+    {
+    case 'S': opCode = OP_START; return true;
+    case 'A': opCode = OP_APPLICATION; return true;
+    case 'P': opCode = OP_PROCESS; return true;
+    case 'I': opCode = OP_INPUT; return true;
+    case 'O': opCode = OP_OUTPUT; return true;
+    case 'M': opCode = OP_MEMORY; return true;
+    }
+    return false;
+}
+/**
+ * @name readDevice
+ *
+ * @details converts a descriptor into a device without exiting, start is the same as begin
+ *
+ * @param descriptor
+ * @param length
+ * @param device
+ *      set when the descriptor is known
+ * @return
+ *      false for any other descriptor
+ */
+bool readDevice(const char *descriptor, unsigned int length, Device &device)
+{
+    if (length == 5 && strncmp(descriptor, "start", 5) == 0)
+    {
+        device = DEV_BEGIN;
+        return true;
+    }
+    for (int i = 0; i < DEV_COUNT; i++)
+    {
+        if (strlen(deviceNames[i]) == length && strncmp(descriptor, deviceNames[i], length) == 0)
+        {
+            device = static_cast<Device>(i);
+            return true;
+        }
+    }
+    return false;
+}
+/**
+ * @name toOpCode
+ *
+ * @details converts a metadata code letter into an opcode
+ *
+ * @param code
+ * @return
+ */
+OpCode toOpCode(char code)
+{
+    OpCode opCode;
+    if (!readOpCode(code, opCode))
+    {
+        cerr << "Error, invalid metadata code" << endl;
+        exit(0);
+    }
+    return opCode;
+}
+/**
+ * @name toDevice
+ *
+ * @details converts a descriptor into a device, start is the same as begin, any other
+ *          descriptor is an error
+ *
+ * @param descriptor
+ * @param length
+ * @return
+ */
+Device toDevice(const char *descriptor, unsigned int length)
+{
+    Device device;
+    if (!readDevice(descriptor, length, device))
+    {
+        cerr << "Error, invalid metadata descriptor " << string(descriptor, length) << endl;
+        exit(0);
+    }
+    return device;
+}
+/**
+ * @name makeOperation
+ *
+ * @details builds an operation record
+ *
+ * @param code
+ * @param device
+ * @param cycles
+ * @return
+ */
+Operation makeOperation(OpCode code, Device device, int cycles)
+{
+    Operation op;
+    op.code = code;
+    op.device = device;
+    op.timing = 0;
+    op.cycles = cycles;
+    return op;
+}
+//
+const char *deviceName(uint8_t device)
+{
+    return device < DEV_COUNT ? deviceNames[device] : "";
+}
+//
+bool isApplication(const Operation &op, Device device, int cycles)
+{
+    return op.code == OP_APPLICATION && op.device == device && op.cycles == cycles;
+}
+//
+bool isIO(const Operation &op)
+{
+    return op.code == OP_INPUT || op.code == OP_OUTPUT;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file operation.h
+ *
+ * @brief header file for the packed operation record
+ *
+ * @details every metadata operation is turned into an 8 byte record when the file is
+ *          loaded so the scheduler never has to compare or convert strings
+ */
+#ifndef OPERATION_H
+#define OPERATION_H
+
+#include <string>
+#include <stdint.h>
+
+using namespace std;
+
+//metadata codes
+enum OpCode
+{
+    OP_START,
+    OP_APPLICATION,
+    OP_PROCESS,
+    OP_INPUT,
+    OP_OUTPUT,
+    OP_MEMORY,
+    OP_CODE_COUNT
+};
+
+//metadata descriptors
+enum Device
+{
+    DEV_BEGIN,
+    DEV_FINISH,
+    DEV_RUN,
+    DEV_HARDDRIVE,
+    DEV_KEYBOARD,
+    DEV_MOUSE,
+    DEV_MONITOR,
+    DEV_PRINTER,
+    DEV_BLOCK,
+    DEV_ALLOCATE,
+    DEV_COUNT
+};
+
+struct Operation
+{
+    uint8_t code;
+    uint8_t device;
+    uint16_t timing; //deadline and period of an A{begin}, index + 1 into the metadata timings, 0 if none
+    int32_t cycles;
+};
+
+static_assert(sizeof(Operation) == 8, "operation record has to stay 8 bytes");
+
+//conversion functions used when loading
+OpCode toOpCode(char code);
+Device toDevice(const char *descriptor, unsigned int length);
+//same conversions for threads that can not exit, false on an unknown code or descriptor
+bool readOpCode(char code, OpCode &opCode);
+bool readDevice(const char *descriptor, unsigned int length, Device &device);
+Operation makeOperation(OpCode code, Device device, int cycles);
+//descriptor text used when logging
+const char *deviceName(uint8_t device);
+//checks for the operations the schedulers look for
+bool isApplication(const Operation &op, Device device, int cycles);
+bool isIO(const Operation &op);
+
+#endif // !OPERATION_H
@@ -0,0 +1,79 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file processTable.cpp
+ *
+ * @brief implementation file for STR process table class
+ *
+ * @details the I/O count of a process is worked out once when it is added, the set is only
+ *          touched by the thread running the schedule so nothing here is locked
+ *
+ */
+#include <set>
+#include <vector>
+
+#include "processTable.h"
+using namespace std;
+
+ProcessTable::ProcessTable() {
+    this->nextOrder = 0;
+}
+
+/**
+ * @details: appends the operations and records where each process starts and ends
+ * @param operations
+ *        whole processes, a process missing its A{finish}0 runs to the end of the operations
+ */
+void ProcessTable::add(const vector<Operation> &operations) {
+    size_t offset = this->operations.size();
+    this->operations.insert(this->operations.end(), operations.begin(), operations.end());
+
+    Entry entry;
+    bool started = false;
+    for(size_t i = 0; i < operations.size(); i++){
+        const Operation &operation = operations[i];
+        //a process put back after an interrupt begins with its id
+        if(operation.code == OP_APPLICATION && operation.device == DEV_BEGIN){
+            started = true;
+            entry.begin = offset + i;
+            entry.ioCount = 0;
+        }else if(started && isIO(operation)){
+            entry.ioCount++;
+        }
+        if(started && (isApplication(operation, DEV_FINISH, 0) || i + 1 == operations.size())){
+            started = false;
+            entry.end = offset + i + 1;
+            entry.order = this->nextOrder++;
+            this->waiting.insert(entry);
+        }
+    }
+}
+
+bool ProcessTable::empty() const {
+    return this->waiting.empty();
+}
+
+/**
+ * @details: moves the first process in the set to the front of the schedule
+ * @param schedule
+ *        operations left to run
+ */
+void ProcessTable::next(vector<Operation> &schedule) {
+    Entry entry = *this->waiting.begin();
+    this->waiting.erase(this->waiting.begin());
+    schedule.insert(schedule.begin(), this->operations.begin() + entry.begin, this->operations.begin() + entry.end);
+    //nothing points at the operations any more
+    if(this->waiting.empty()){
+        this->operations.clear();
+    }
+}
+
+bool ProcessTable::Before::operator()(const Entry &a, const Entry &b) const {
+    if((a.ioCount == 0) != (b.ioCount == 0)){
+        return a.ioCount != 0;
+    }
+    if(a.ioCount != b.ioCount){
+        return a.ioCount < b.ioCount;
+    }
+    return a.order < b.order;
+}
@@ -0,0 +1,54 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file processTable.h
+ *
+ * @brief header for STR process table class
+ *
+ * @details processes waiting to run under STR are kept in a set ordered by how many I/O
+ *          operations they have, so picking the next one and adding loaded ones is O(log P)
+ *          and loading a program only appends its operations
+ *
+ */
+#ifndef PROCESSTABLE_H
+#define PROCESSTABLE_H
+
+#include <set>
+#include <vector>
+
+#include "operation.h"
+using namespace std;
+
+class ProcessTable {
+    public:
+        ProcessTable();
+        // adds every process in the operations, each runs from its A{begin} to its A{finish}0
+        void add(const vector<Operation> &operations);
+        // true if no process is waiting
+        bool empty() const;
+        // takes out the process with the fewest I/O operations and puts it at the front of
+        // the schedule
+        void next(vector<Operation> &schedule);
+
+    private:
+        struct Entry {
+            // range of the process in operations
+            size_t begin;
+            size_t end;
+            int ioCount;
+            // order the process was added in
+            unsigned long long order;
+        };
+        // fewest I/O first, processes without any I/O go last, then the order they came in
+        struct Before {
+            bool operator()(const Entry&, const Entry&) const;
+        };
+
+        // operations of every waiting process, only appended to until the table is empty
+        vector<Operation> operations;
+        set<Entry, Before> waiting;
+        unsigned long long nextOrder;
+};
+
+
+#endif // !PROCESSTABLE_H
@@ -6,80 +6,101 @@
  */
 
 #include "resourceManager.h"
+#include <iostream>
+#include <cstdlib>
 /**
  * @name resourceStart
  *
- * @detiails initializes all of the resource queues
+ * @detiails marks every instance of every device as free
  *
  * @param config
  */
 void Resource::resourceStart(Config &config)
 {
-    // initialize hard drive queue
-	for (int i = 0; i < config.getHarddriveResources(); i++)
+	for (int device = 0; device < DEV_COUNT; device++)
 	{
-		harddrive.push_back(i);
-	}
-    // initialize keyboard queue
-	for (int i = 0; i < config.getKeyboardResources(); i++)
-	{
-		keyboard.push_back(i);
-	}
-    // initialize monitor queue
-	for (int i = 0; i < config.getMonitorResources(); i++)
-	{
-		monitor.push_back(i);
-	}
-    // initialize printer queue
-	for (int i = 0; i < config.getPrinterResources(); i++)
-	{
-		printer.push_back(i);
-	}
-	// initialize mouse queue
-	for (int i = 0; i < config.getMouseResources(); i++)
-	{
-		mouse.push_back(i);
+		setInstances(device, 0);
 	}
+	setInstances(DEV_HARDDRIVE, config.getHarddriveResources());
+	setInstances(DEV_KEYBOARD, config.getKeyboardResources());
+	setInstances(DEV_MONITOR, config.getMonitorResources());
+	setInstances(DEV_PRINTER, config.getPrinterResources());
+	setInstances(DEV_MOUSE, config.getMouseResources());
 }
 /**
- * @name resourceManagement
+ * @name setInstances
  *
- * @details handles the counting for the resouces used
+ * @details sets how many instances a device has, all of them free
  *
- * @param descriptor
+ * @param device
+ * @param count
  */
-void Resource::resourceManagement(string descriptor)
+void Resource::setInstances(uint8_t device, int count)
 {
-	int index;
-    //pushes the resource to the front and moves it to the back after being used
-	if (descriptor == "hard drive")
+	if (count < 0)
 	{
-		index = harddrive.front();
-		harddrive.pop_front();
-		harddrive.push_back(index);
+		cerr << "Error! A device can not have a negative number of resources" << endl;
+		exit(0);
 	}
-	else if (descriptor == "keyboard")
+	if (count > MAX_INSTANCES)
 	{
-		index = keyboard.front();
-		keyboard.pop_front();
-		keyboard.push_back(index);
+		cerr << "Error! A device can have at most " << MAX_INSTANCES << " resources" << endl;
+		exit(0);
 	}
-	else if (descriptor == "mouse")
-	{
-		index = mouse.front();
-		mouse.pop_front();
-		mouse.push_back(index);
-	}
-	else if (descriptor == "monitor")
+	instances[device] = count;
+	freeInstances[device].store(count == MAX_INSTANCES ? ~0ULL : (1ULL << count) - 1);
+	nextInstance[device].store(0);
+}
+/**
+ * @name acquire
+ *
+ * @details takes a free instance of a device, starting from the one after the instance taken
+ *          last so the instances are used in turn
+ *
+ * @param device
+ * @return
+ *      the instance taken, -1 if every instance is in use
+ */
+int Resource::acquire(uint8_t device)
+{
+	uint64_t available = freeInstances[device].load();
+	while (available != 0)
 	{
-		index = monitor.front();
-		monitor.pop_front();
-		monitor.push_back(index);
+		uint64_t ahead = available & (~0ULL << nextInstance[device].load(memory_order_relaxed));
+		int instance = __builtin_ctzll(ahead != 0 ? ahead : available);
+		//only one thread can clear the bit, a failed exchange reloads available and tries again
+		if (freeInstances[device].compare_exchange_weak(available, available & ~(1ULL << instance)))
+		{
+			nextInstance[device].store((instance + 1) % instances[device], memory_order_relaxed);
+			return instance;
+		}
 	}
-	else if (descriptor == "printer")
+	return -1;
+}
+/**
+ * @name release
+ *
+ * @details gives an instance back to its device
+ *
+ * @param device
+ * @param instance
+ */
+void Resource::release(uint8_t device, int instance)
+{
+	if (instance >= 0)
 	{
-		index = printer.front();
-		printer.pop_front();
-		printer.push_back(index);
+		freeInstances[device].fetch_or(1ULL << instance);
 	}
-}
\ No newline at end of file
+}
+/**
+ * @name instanceCount
+ *
+ * @details gets how many instances a device has
+ *
+ * @param device
+ * @return
+ */
+int Resource::instanceCount(uint8_t device) const
+{
+	return instances[device];
+}
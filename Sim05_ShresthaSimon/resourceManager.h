@@ -3,29 +3,37 @@
  *
  * @brief header file for Resource class
  *
- * @details handles the resources for the different IO devices
+ * @details handles the resources for the different IO devices. Each device keeps a bitmap of
+ *          its free instances, so taking and giving back an instance is one atomic operation and
+ *          every instance of a device can be in use at the same time
  */
 #ifndef RESOURCEMANAGER_H
 #define RESOURCEMANAGER_H
 
 #include "config.h"
-#include <deque>
+#include "operation.h"
+#include <atomic>
+#include <cstdint>
 
 using namespace std;
 
 class Resource
 {
 public:
-    deque<int> harddrive;
-    deque<int> keyboard;
-    deque<int> monitor;
-    deque<int> printer;
-    deque<int> mouse;
+    //most instances a device can have, one per bit
+    static const int MAX_INSTANCES = 64;
     void resourceStart(Config &config);
-    void resourceManagement(string descriptor);
+    int acquire(uint8_t device);
+    void release(uint8_t device, int instance);
+    int instanceCount(uint8_t device) const;
 private:
+    //bit i is set while instance i is free
+    atomic<uint64_t> freeInstances[DEV_COUNT];
+    //instance to try first, keeps the instances taking turns
+    atomic<int> nextInstance[DEV_COUNT];
+    int instances[DEV_COUNT];
+    void setInstances(uint8_t device, int count);
 
 };
 
 #endif // !RESOURCEMANAGER_H
-
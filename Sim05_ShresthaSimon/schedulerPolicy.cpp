@@ -0,0 +1,1151 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file schedulerPolicy.cpp
+ *
+ * @brief implementation file for the scheduling policies
+ *
+ * @details one class per CPU Scheduling Code the processors run
+ *
+ */
+#include "schedulerPolicy.h"
+#include "timerService.h"
+#include <cerrno>
+#include <sstream>
+using namespace std;
+
+typedef chrono::high_resolution_clock Time;
+//when the simulator started, set in OperatingSystem.cpp
+extern chrono::high_resolution_clock::time_point timeInit;
+//MLFQ priority levels, each one has twice the quantum of the level above
+static const int MLFQ_LEVELS = 3;
+//every process goes back to the top level after this many base quanta
+static const int MLFQ_BOOST_QUANTA = 20;
+//CFS weight of each nice value, a step up in nice is about 10% less processor time
+static const int NICE_WEIGHTS[] = {1024, 820, 655, 526, 423, 335, 272, 215, 172, 137, 110, 87, 70, 56, 45, 36, 29, 23, 18, 15};
+static const int MAX_NICE = 19;
+//STRIDE and LOTTERY tickets of a process whose A{begin} has no cycles
+static const int DEFAULT_TICKETS = 100;
+//most a LOTTERY process that gave up its quantum early has its tickets multiplied by
+static const int MAX_COMPENSATION = 8;
+/**
+ * @name timeStamp
+ *
+ * @details seconds since the simulator started, printed at the start of a line
+ * @return
+ */
+static double timeStamp(){
+	return OperatingSystem::calculateTime(timeInit, Time::now());
+}
+/**
+ * @name stateOf
+ *
+ * @details the state a policy gave a process when it was admitted
+ * @param block
+ * @return
+ */
+template <class State>
+static State *stateOf(const ProcessControlBlock *block){
+	return static_cast<State*>(block->state.get());
+}
+
+PolicyState::~PolicyState(){
+
+}
+
+/**
+ * @details: lowest key first, then the order the processes were admitted in
+ */
+bool KeyBefore::operator()(const ProcessControlBlock *a, const ProcessControlBlock *b) const {
+	chrono::nanoseconds keyA = stateOf<TreeState>(a)->key;
+	chrono::nanoseconds keyB = stateOf<TreeState>(b)->key;
+	if (keyA != keyB){
+		return keyA < keyB;
+	}
+	return a->order < b->order;
+}
+
+SchedulerPolicy::SchedulerPolicy(Config *config){
+	this->config = config;
+}
+
+SchedulerPolicy::~SchedulerPolicy(){
+
+}
+
+/**
+ * @name create
+ *
+ * @details makes the policy for a CPU Scheduling Code
+ * @param code
+ * @param config
+ * @return
+ *      NULL for STR and any other code the processors do not run
+ */
+SchedulerPolicy *SchedulerPolicy::create(const string &code, Config *config){
+	if (code == "RR"){
+		return new RoundRobinPolicy(config);
+	}else if (code == "MLFQ"){
+		return new MlfqPolicy(config);
+	}else if (code == "CFS"){
+		return new FairSharePolicy(config);
+	}else if (code == "STRIDE"){
+		return new StridePolicy(config);
+	}else if (code == "LOTTERY"){
+		return new LotteryPolicy(config);
+	}else if (code == "SRTF"){
+		return new SrtfPolicy(config);
+	}else if (code == "EDF"){
+		return new EdfPolicy(config);
+	}
+	return NULL;
+}
+
+//one level unless the policy has more
+int SchedulerPolicy::levels() const {
+	return 1;
+}
+
+//every process waits in the one level unless the policy has more
+int SchedulerPolicy::level(const ProcessControlBlock *block) const {
+	return 0;
+}
+
+//nothing to set up unless the policy keeps something on the processor
+void SchedulerPolicy::addProcessor(Processor &cpu, size_t capacity){
+
+}
+
+//RR keeps nothing for a process
+void SchedulerPolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+
+}
+
+//every set fits unless the policy checks
+bool SchedulerPolicy::admitSet(deque<ProcessControlBlock> &blocks, size_t first, size_t processors){
+	return true;
+}
+
+//nothing is due unless the policy has something to do
+void SchedulerPolicy::tick(){
+
+}
+
+//nothing to check unless the policy preempts
+void SchedulerPolicy::startQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::high_resolution_clock::time_point start){
+
+}
+
+void SchedulerPolicy::startOperation(ProcessControlBlock *block, const Operation &op){
+
+}
+
+//waits out the slice, nothing can cut it short
+chrono::nanoseconds SchedulerPolicy::runSlice(Processor &cpu, const chrono::nanoseconds slice){
+	TimerService::instance().sleepFor(slice);
+	return slice;
+}
+
+//a process never keeps the processor unless the policy preempts
+bool SchedulerPolicy::endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done){
+	return false;
+}
+
+//a process that is done never comes back unless the policy releases it again
+bool SchedulerPolicy::finish(ProcessControlBlock *block){
+	return false;
+}
+
+ProcessControlBlock *SchedulerPolicy::release(){
+	return NULL;
+}
+
+chrono::high_resolution_clock::time_point SchedulerPolicy::nextRelease(const chrono::high_resolution_clock::time_point until){
+	return until;
+}
+
+void SchedulerPolicy::report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks){
+
+}
+
+RoundRobinPolicy::RoundRobinPolicy(Config *config) : SchedulerPolicy(config){
+
+}
+
+/**
+ * @name enqueue
+ *
+ * @details puts a process at the back of the queue for its level. Only the processor adds to
+ *          its own levels, any other thread leaves the process in its inbox
+ * @param cpu
+ * @param block
+ * @param owner
+ */
+void RoundRobinPolicy::enqueue(Processor &cpu, ProcessControlBlock *block, bool owner){
+	if (owner){
+		//processes other threads queued came first
+		drainInbox(cpu);
+		pushReady(cpu.readyLevels[level(block)].ready, block);
+	}else{
+		block->nextQueued = cpu.inbox.load();
+		while (!(cpu.inbox.compare_exchange_weak(block->nextQueued, block))){
+		}
+	}
+}
+
+/**
+ * @name pick
+ *
+ * @details takes the process at the front of the highest level that has one, only the
+ *          processor itself calls this and it moves its inbox to its levels first
+ * @param cpu
+ * @param owner
+ * @return
+ */
+ProcessControlBlock *RoundRobinPolicy::pick(Processor &cpu, bool owner){
+	drainInbox(cpu);
+	return takeReady(cpu);
+}
+
+/**
+ * @name steal
+ *
+ * @details takes the oldest process of another processor, processes it has not moved out of
+ *          its inbox yet can be taken too
+ * @param cpu
+ * @param busiest
+ * @return
+ */
+ProcessControlBlock *RoundRobinPolicy::steal(Processor &cpu, Processor &busiest){
+	ProcessControlBlock *block = takeReady(busiest);
+	if (block == NULL){
+		block = takeInbox(cpu, busiest);
+	}
+	return block;
+}
+
+/**
+ * @name pushReady
+ *
+ * @details adds a process to a level of a ready queue
+ * @param ready
+ * @param block
+ */
+void RoundRobinPolicy::pushReady(FifoRing<ProcessControlBlock*> &ready, ProcessControlBlock *block){
+	if (!(ready.push(block))){
+		cerr << "Error, too many processes for the ready queue" << endl;
+		exit(0);
+	}
+}
+
+/**
+ * @name takeReady
+ *
+ * @details takes the oldest process of the highest level that has one, any processor can
+ *          take from any other without a lock
+ * @param cpu
+ *      processor to take from
+ * @return
+ *      NULL if its levels are empty
+ */
+ProcessControlBlock *RoundRobinPolicy::takeReady(Processor &cpu){
+	ProcessControlBlock *block;
+	for (ReadyLevel &level : cpu.readyLevels){
+		if (level.ready.pop(block)){
+			cpu.queued--;
+			return block;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @name drainInbox
+ *
+ * @details moves the processes other threads queued to the levels of the processor, in the
+ *          order they were queued. Only called by the processor itself
+ * @param cpu
+ */
+void RoundRobinPolicy::drainInbox(Processor &cpu){
+	ProcessControlBlock *block = cpu.inbox.exchange(NULL);
+	ProcessControlBlock *ordered = NULL;
+	//the inbox is a stack, newest first
+	while (block != NULL){
+		ProcessControlBlock *next = block->nextQueued;
+		block->nextQueued = ordered;
+		ordered = block;
+		block = next;
+	}
+	while (ordered != NULL){
+		//read first, once it is queued another processor can take it
+		ProcessControlBlock *next = ordered->nextQueued;
+		pushReady(cpu.readyLevels[level(ordered)].ready, ordered);
+		ordered = next;
+	}
+}
+
+/**
+ * @name takeInbox
+ *
+ * @details takes every process in the inbox of another processor that has not got to them
+ *          yet, the first one is returned and the rest are queued on this processor
+ * @param cpu
+ *      processor taking them
+ * @param other
+ * @return
+ *      NULL if the inbox is empty
+ */
+ProcessControlBlock *RoundRobinPolicy::takeInbox(Processor &cpu, Processor &other){
+	ProcessControlBlock *block = other.inbox.exchange(NULL);
+	ProcessControlBlock *ordered = NULL;
+	int count = 0;
+	while (block != NULL){
+		ProcessControlBlock *next = block->nextQueued;
+		block->nextQueued = ordered;
+		ordered = block;
+		block = next;
+		count++;
+	}
+	if (ordered == NULL){
+		return NULL;
+	}
+	other.queued -= count;
+	block = ordered;
+	ordered = ordered->nextQueued;
+	while (ordered != NULL){
+		ProcessControlBlock *next = ordered->nextQueued;
+		ordered->processor = cpu.id;
+		pushReady(cpu.readyLevels[level(ordered)].ready, ordered);
+		cpu.queued++;
+		ordered = next;
+	}
+	return block;
+}
+
+MlfqPolicy::MlfqPolicy(Config *config) : RoundRobinPolicy(config), boostEpoch(0){
+	boostTime = Time::now() + chrono::milliseconds(config->getCPUQuantumNumber() * MLFQ_BOOST_QUANTA);
+}
+
+//every level down doubles the quantum
+int MlfqPolicy::levels() const {
+	return MLFQ_LEVELS;
+}
+
+int MlfqPolicy::level(const ProcessControlBlock *block) const {
+	return stateOf<MlfqState>(block)->level;
+}
+
+//a new process starts at the top level
+void MlfqPolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+	MlfqState *state = new MlfqState();
+	state->level = 0;
+	block->state.reset(state);
+}
+
+/**
+ * @name pick
+ *
+ * @details same as RR, but a processor that has not boosted since the last boost was due
+ *          does it first
+ * @param cpu
+ * @param owner
+ * @return
+ */
+ProcessControlBlock *MlfqPolicy::pick(Processor &cpu, bool owner){
+	drainInbox(cpu);
+	if (cpu.boostEpoch != boostEpoch){
+		cpu.boostEpoch = boostEpoch;
+		boostLevels(cpu);
+	}
+	return takeReady(cpu);
+}
+
+/**
+ * @name tick
+ *
+ * @details makes a boost due every few quanta so processes that moved down are not starved
+ */
+void MlfqPolicy::tick(){
+	if (Time::now() >= boostTime){
+		boostEpoch++;
+		boostTime = Time::now() + chrono::milliseconds(config->getCPUQuantumNumber() * MLFQ_BOOST_QUANTA);
+	}
+}
+
+/**
+ * @name boostLevels
+ *
+ * @details moves every process below the top level of a processor back to the top, in
+ *          level order. Only called by the processor itself
+ * @param cpu
+ */
+void MlfqPolicy::boostLevels(Processor &cpu){
+	bool moved = false;
+	ProcessControlBlock *block;
+	for (size_t i = 1; i < cpu.readyLevels.size(); i++){
+		while (cpu.readyLevels[i].ready.pop(block)){
+			stateOf<MlfqState>(block)->level = 0;
+			pushReady(cpu.readyLevels[0].ready, block);
+			moved = true;
+		}
+	}
+	if (moved){
+		OperatingSystem::logLine(timeStamp(), "OS: moving every process to the top queue");
+	}
+}
+
+/**
+ * @name endQuantum
+ *
+ * @details a process that used its whole quantum moves down one level
+ * @param cpu
+ * @param block
+ * @param ran
+ * @param done
+ *      true if the process blocked or ended
+ * @return
+ */
+bool MlfqPolicy::endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done){
+	MlfqState *state = stateOf<MlfqState>(block);
+	if (!done && state->level + 1 < (int) cpu.readyLevels.size()){
+		cpu.readyLevels[state->level].demotions++;
+		state->level++;
+	}
+	return false;
+}
+
+/**
+ * @name report
+ *
+ * @details prints how much each MLFQ level was used on every processor together
+ * @param processors
+ * @param blocks
+ */
+void MlfqPolicy::report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks){
+	for (size_t i = 0; i < processors.front().readyLevels.size(); i++){
+		ReadyLevel total;
+		total.quanta = 0;
+		total.demotions = 0;
+		total.used = chrono::nanoseconds(0);
+		for (const Processor &cpu : processors){
+			total.quanta += cpu.readyLevels[i].quanta;
+			total.demotions += cpu.readyLevels[i].demotions;
+			total.used += cpu.readyLevels[i].used;
+		}
+		ostringstream used;
+		used << fixed << setprecision(6) << chrono::duration<double>(total.used).count();
+		OperatingSystem::logLine(timeStamp(), "OS: queue " + to_string(i) + " with a " + to_string(config->getCPUQuantumNumber() << i) + " ms quantum ran "
+			+ to_string(total.quanta) + " quanta for " + used.str() + " seconds, " + to_string(total.demotions) + " processes moved down");
+	}
+}
+
+TreePolicy::TreePolicy(Config *config) : SchedulerPolicy(config){
+
+}
+
+/**
+ * @name enqueue
+ *
+ * @details puts a process into the tree of the processor by its key, any thread can queue
+ *          on any processor since the tree is under the lock
+ * @param cpu
+ * @param block
+ * @param owner
+ */
+void TreePolicy::enqueue(Processor &cpu, ProcessControlBlock *block, bool owner){
+	pthread_mutex_lock(&cpu.lock);
+	place(cpu, block);
+	insert(cpu, block);
+	pthread_mutex_unlock(&cpu.lock);
+}
+
+/**
+ * @name pick
+ *
+ * @details takes the process with the lowest key. A processor gets back the process it kept
+ *          running unless one that goes first is queued, then the kept one is interrupted,
+ *          only SRTF and EDF keep a process
+ * @param cpu
+ * @param owner
+ * @return
+ */
+ProcessControlBlock *TreePolicy::pick(Processor &cpu, bool owner){
+	ProcessControlBlock *block = NULL;
+	ProcessControlBlock *interrupted = NULL;
+	pthread_mutex_lock(&cpu.lock);
+	//other processors never take the kept process, it is not in the tree
+	if (owner && cpu.kept != NULL){
+		if (cpu.orderedQueue.empty() || !(stateOf<TreeState>(*cpu.orderedQueue.begin())->key < stateOf<TreeState>(cpu.kept)->key)){
+			pthread_mutex_unlock(&cpu.lock);
+			return cpu.kept;
+		}
+		interrupted = cpu.kept;
+		cpu.kept = NULL;
+	}
+	block = take(cpu);
+	if (block != NULL){
+		taken(cpu, block);
+		cpu.queued--;
+	}
+	pthread_mutex_unlock(&cpu.lock);
+	if (interrupted != NULL){
+		OperatingSystem::logLine(timeStamp(), "Process " + to_string(interrupted->id) + ": interrupt processing action");
+		OperatingSystem::readyProcess(cpu, interrupted);
+	}
+	return block;
+}
+
+//takes the next process of the other processor the way it would itself
+ProcessControlBlock *TreePolicy::steal(Processor &cpu, Processor &busiest){
+	return pick(busiest, false);
+}
+
+void TreePolicy::insert(Processor &cpu, ProcessControlBlock *block){
+	cpu.orderedQueue.insert(block);
+}
+
+//leftmost process in the tree
+ProcessControlBlock *TreePolicy::take(Processor &cpu){
+	if (cpu.orderedQueue.empty()){
+		return NULL;
+	}
+	ProcessControlBlock *block = *cpu.orderedQueue.begin();
+	cpu.orderedQueue.erase(cpu.orderedQueue.begin());
+	return block;
+}
+
+void TreePolicy::taken(Processor &cpu, ProcessControlBlock *block){
+
+}
+
+FairSharePolicy::FairSharePolicy(Config *config) : TreePolicy(config){
+
+}
+
+/**
+ * @name admit
+ *
+ * @details the cycles of A{begin} are the nice value, which gives the CFS weight
+ * @param block
+ * @param begin
+ *      A{begin} of the process
+ * @param timing
+ */
+void FairSharePolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+	NiceState *state = new NiceState();
+	state->nice = min(begin.cycles, MAX_NICE);
+	admitShare(state, NICE_WEIGHTS[state->nice]);
+	block->state.reset(state);
+}
+
+//a new process has had no processor time and is owed none
+void FairSharePolicy::admitShare(FairShareState *state, int weight){
+	state->key = chrono::nanoseconds(0);
+	state->weight = weight;
+	state->vruntime = chrono::nanoseconds(0);
+	state->fairTime = 0;
+	state->readyClock = 0;
+}
+
+/**
+ * @name place
+ *
+ * @details a process that is new or was blocked starts at the lowest virtual runtime so far,
+ *          otherwise it would hold the processor until it caught up
+ * @param cpu
+ * @param block
+ */
+void FairSharePolicy::place(Processor &cpu, ProcessControlBlock *block){
+	FairShareState *state = stateOf<FairShareState>(block);
+	state->vruntime = max(state->vruntime, cpu.minVruntime);
+	state->readyClock = cpu.fairClock;
+	cpu.fairWeight += state->weight;
+	state->key = state->vruntime;
+}
+
+/**
+ * @name taken
+ *
+ * @details moves the lowest virtual runtime up and adds what the process was owed while it
+ *          waited
+ * @param cpu
+ * @param block
+ */
+void FairSharePolicy::taken(Processor &cpu, ProcessControlBlock *block){
+	FairShareState *state = stateOf<FairShareState>(block);
+	cpu.minVruntime = max(cpu.minVruntime, state->vruntime);
+	cpu.fairWeight -= state->weight;
+	state->fairTime += state->weight * (cpu.fairClock - state->readyClock);
+}
+
+/**
+ * @name steal
+ *
+ * @details a process comes off a tree at its lowest virtual runtime, here it starts at this
+ *          processor's
+ * @param cpu
+ * @param busiest
+ * @return
+ */
+ProcessControlBlock *FairSharePolicy::steal(Processor &cpu, Processor &busiest){
+	ProcessControlBlock *block = TreePolicy::steal(cpu, busiest);
+	if (block != NULL){
+		pthread_mutex_lock(&cpu.lock);
+		stateOf<FairShareState>(block)->vruntime = cpu.minVruntime;
+		pthread_mutex_unlock(&cpu.lock);
+	}
+	return block;
+}
+
+/**
+ * @name endQuantum
+ *
+ * @details adds the processor time the process had to its virtual runtime scaled by its
+ *          weight, that time is owed to everything that could have run in proportion to
+ *          weight. Time it waited on a device is not charged, the processor did no work
+ * @param cpu
+ * @param block
+ * @param ran
+ *      processor time of the quantum
+ * @param done
+ * @return
+ */
+bool FairSharePolicy::endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done){
+	FairShareState *state = stateOf<FairShareState>(block);
+	state->vruntime += ran * NICE_WEIGHTS[0] / state->weight;
+	pthread_mutex_lock(&cpu.lock);
+	double owed = chrono::duration<double>(ran).count() / (cpu.fairWeight + state->weight);
+	cpu.fairClock += owed;
+	state->fairTime += state->weight * owed;
+	pthread_mutex_unlock(&cpu.lock);
+	return false;
+}
+
+/**
+ * @name report
+ *
+ * @details prints how fairly the processor was shared. The fairness of a process is the
+ *          processor time it had over the time an exactly fair processor would have given it
+ *          for its weight while it was ready or running, so 1 is an exact share. The last
+ *          line is Jain's index of those, 1 when every process got its share
+ * @param processors
+ * @param blocks
+ */
+void FairSharePolicy::report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks){
+	double sum = 0, squares = 0;
+	int count = 0;
+	for (const ProcessControlBlock &block : blocks){
+		double fairTime = stateOf<FairShareState>(&block)->fairTime;
+		if (fairTime <= 0){
+			continue;
+		}
+		double fairness = chrono::duration<double>(block.cpuTime).count() / fairTime;
+		sum += fairness;
+		squares += fairness * fairness;
+		count++;
+		OperatingSystem::logLine(timeStamp(), shareLine(block, fairness));
+	}
+	if (count == 0){
+		return;
+	}
+	ostringstream index;
+	index << fixed << setprecision(3) << "OS: fairness index " << sum * sum / (count * squares);
+	OperatingSystem::logLine(timeStamp(), index.str());
+}
+
+//share of a process against its nice value
+string FairSharePolicy::shareLine(const ProcessControlBlock &block, double fairness) const {
+	ostringstream line;
+	const NiceState *state = stateOf<NiceState>(&block);
+	line << fixed << setprecision(6) << "OS: process " << block.id << " with nice " << state->nice << " ran " << chrono::duration<double>(block.cpuTime).count()
+		<< " seconds for a fair share of " << state->fairTime << ", fairness " << setprecision(3) << fairness;
+	return line.str();
+}
+
+StridePolicy::StridePolicy(Config *config) : FairSharePolicy(config){
+
+}
+
+/**
+ * @name admit
+ *
+ * @details the cycles of A{begin} are the tickets of the process, 0 gives it the default
+ * @param block
+ * @param begin
+ * @param timing
+ */
+void StridePolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+	FairShareState *state = new FairShareState();
+	admitShare(state, begin.cycles > 0 ? begin.cycles : DEFAULT_TICKETS);
+	block->state.reset(state);
+}
+
+//share of a process against the share its tickets asked for
+string StridePolicy::shareLine(const ProcessControlBlock &block, double fairness) const {
+	ostringstream line;
+	const FairShareState *state = stateOf<FairShareState>(&block);
+	line << fixed << setprecision(6) << "OS: process " << block.id << " with " << state->weight << " tickets ran " << chrono::duration<double>(block.cpuTime).count()
+		<< " seconds for a requested share of " << state->fairTime << ", achieved over requested " << setprecision(3) << fairness;
+	return line.str();
+}
+
+LotteryPolicy::LotteryPolicy(Config *config) : StridePolicy(config){
+
+}
+
+/**
+ * @name addProcessor
+ *
+ * @details gives the processor a slot for every process, every processor draws the same
+ *          numbers on every run
+ * @param cpu
+ * @param capacity
+ */
+void LotteryPolicy::addProcessor(Processor &cpu, size_t capacity){
+	cpu.lottery.setCapacity(capacity);
+	cpu.lotterySlots.assign(capacity, NULL);
+	cpu.lotteryDraw.seed(cpu.id + 1);
+}
+
+//a process is drawn with its own tickets until it gives up part of a quantum
+void LotteryPolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+	LotteryState *state = new LotteryState();
+	admitShare(state, begin.cycles > 0 ? begin.cycles : DEFAULT_TICKETS);
+	state->tickets = state->weight;
+	block->state.reset(state);
+}
+
+/**
+ * @name endQuantum
+ *
+ * @details a process that used only part of its quantum, because it waited on a device or
+ *          blocked, is drawn with its tickets over that part until it wins again. Otherwise
+ *          it would win as often as its tickets ask for but get less processor time each win
+ * @param cpu
+ * @param block
+ * @param ran
+ *      processor time of the quantum
+ * @param done
+ * @return
+ */
+bool LotteryPolicy::endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done){
+	chrono::nanoseconds quantum = chrono::milliseconds(config->getCPUQuantumNumber());
+	LotteryState *state = stateOf<LotteryState>(block);
+	FairSharePolicy::endQuantum(cpu, block, ran, done);
+	state->tickets = state->weight;
+	if (ran < quantum){
+		state->tickets = ran * MAX_COMPENSATION > quantum ? state->weight * quantum.count() / ran.count() : state->weight * MAX_COMPENSATION;
+	}
+	return false;
+}
+
+//the order a process was admitted in is its own slot
+void LotteryPolicy::insert(Processor &cpu, ProcessControlBlock *block){
+	cpu.lottery.add(block->order - 1, stateOf<LotteryState>(block)->tickets);
+	cpu.lotterySlots[block->order - 1] = block;
+}
+
+//the process holding a ticket drawn at random
+ProcessControlBlock *LotteryPolicy::take(Processor &cpu){
+	if (cpu.lottery.total() == 0){
+		return NULL;
+	}
+	size_t slot = cpu.lottery.draw(cpu.lotteryDraw() % cpu.lottery.total());
+	ProcessControlBlock *block = cpu.lotterySlots[slot];
+	cpu.lottery.add(slot, -stateOf<LotteryState>(block)->tickets);
+	return block;
+}
+
+PreemptivePolicy::PreemptivePolicy(Config *config) : TreePolicy(config){
+
+}
+
+/**
+ * @name place
+ *
+ * @details a process that goes before the running one preempts it
+ * @param cpu
+ * @param block
+ */
+void PreemptivePolicy::place(Processor &cpu, ProcessControlBlock *block){
+	TreeState *state = stateOf<TreeState>(block);
+	state->key = key(cpu, block);
+	if (cpu.running != NULL && state->key < runningKey(cpu)){
+		cpu.preempt = true;
+		pthread_cond_signal(&cpu.wakeup);
+	}
+}
+
+//the key the running process started its quantum with
+chrono::nanoseconds PreemptivePolicy::runningKey(Processor &cpu){
+	return cpu.runningKey;
+}
+
+/**
+ * @name startQuantum
+ *
+ * @details marks the process as running so one that goes first can preempt it
+ * @param cpu
+ * @param block
+ * @param start
+ */
+void PreemptivePolicy::startQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::high_resolution_clock::time_point start){
+	pthread_mutex_lock(&cpu.lock);
+	cpu.running = block;
+	cpu.runningKey = key(cpu, block);
+	cpu.runningSince = start;
+	cpu.preempt = false;
+	pthread_mutex_unlock(&cpu.lock);
+}
+
+/**
+ * @name runSlice
+ *
+ * @details waits out a slice of a processing action, a process that goes first being queued
+ *          on the processor ends the wait early
+ * @param cpu
+ * @param slice
+ *      how long to wait
+ * @return
+ *      how much of the slice went by
+ */
+chrono::nanoseconds PreemptivePolicy::runSlice(Processor &cpu, const chrono::nanoseconds slice){
+	chrono::high_resolution_clock::time_point start = Time::now();
+	chrono::system_clock::time_point deadline = chrono::system_clock::now() + chrono::duration_cast<chrono::system_clock::duration>(slice);
+	chrono::nanoseconds sinceEpoch = chrono::duration_cast<chrono::nanoseconds>(deadline.time_since_epoch());
+	timespec wake;
+	wake.tv_sec = sinceEpoch.count() / 1000000000;
+	wake.tv_nsec = sinceEpoch.count() % 1000000000;
+
+	pthread_mutex_lock(&cpu.lock);
+	while (!cpu.preempt && pthread_cond_timedwait(&cpu.wakeup, &cpu.lock, &wake) != ETIMEDOUT){
+	}
+	pthread_mutex_unlock(&cpu.lock);
+	return min(slice, chrono::duration_cast<chrono::nanoseconds>(Time::now() - start));
+}
+
+/**
+ * @name endQuantum
+ *
+ * @details a process that still goes first keeps the processor without an interrupt unless
+ *          one that goes first was queued, the next look at the tree decides
+ * @param cpu
+ * @param block
+ * @param ran
+ * @param done
+ *      true if the process blocked or ended
+ * @return
+ */
+bool PreemptivePolicy::endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done){
+	pthread_mutex_lock(&cpu.lock);
+	cpu.running = NULL;
+	if (!done && !cpu.preempt){
+		stateOf<TreeState>(block)->key = key(cpu, block);
+		cpu.kept = block;
+	}
+	cpu.preempt = false;
+	pthread_mutex_unlock(&cpu.lock);
+	return cpu.kept != NULL;
+}
+
+SrtfPolicy::SrtfPolicy(Config *config) : PreemptivePolicy(config){
+
+}
+
+/**
+ * @name admit
+ *
+ * @details with nothing known about a process its first burst is guessed to be a quantum
+ * @param block
+ * @param begin
+ * @param timing
+ */
+void SrtfPolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+	SrtfState *state = new SrtfState();
+	state->key = chrono::nanoseconds(0);
+	state->predicted = chrono::milliseconds(config->getCPUQuantumNumber());
+	state->predictionError = chrono::nanoseconds(0);
+	state->bursts = 0;
+	block->state.reset(state);
+}
+
+/**
+ * @name key
+ *
+ * @details gives the time a process has left. Without a burst prediction weight it is the
+ *          time every operation the process has left takes, less what it already ran of the
+ *          processing action it is on. With one it is the guess for the current burst less
+ *          what the process ran of it, nothing past the burst is looked at
+ * @param cpu
+ * @param block
+ * @return
+ */
+chrono::nanoseconds SrtfPolicy::key(Processor &cpu, const ProcessControlBlock *block){
+	if (config->getBurstWeight() > 0){
+		return max(stateOf<SrtfState>(block)->predicted - block->burst, chrono::nanoseconds(0));
+	}
+	chrono::nanoseconds left = block->work;
+	if (block->remaining.count() > 0){
+		left -= OperatingSystem::operationTime(*cpu.system, block->operations[block->programCounter]) - block->remaining;
+	}
+	return left;
+}
+
+//the running process has less left than it started with
+chrono::nanoseconds SrtfPolicy::runningKey(Processor &cpu){
+	return cpu.runningKey - chrono::duration_cast<chrono::nanoseconds>(Time::now() - cpu.runningSince);
+}
+
+/**
+ * @name startOperation
+ *
+ * @details the process would wait on the device or it is done, either way the burst is over
+ *          and the next one is guessed, the weight of the burst that just ended plus the rest
+ *          of the weight of the old guess
+ * @param block
+ * @param op
+ */
+void SrtfPolicy::startOperation(ProcessControlBlock *block, const Operation &op){
+	if (!(isIO(op) || isApplication(op, DEV_FINISH, 0)) || block->burst.count() == 0){
+		return;
+	}
+	SrtfState *state = stateOf<SrtfState>(block);
+	int weight = config->getBurstWeight();
+	state->predictionError += block->burst > state->predicted ? block->burst - state->predicted : state->predicted - block->burst;
+	state->bursts++;
+	state->predicted = (block->burst * weight + state->predicted * (100 - weight)) / 100;
+	block->burst = chrono::nanoseconds(0);
+}
+
+/**
+ * @name report
+ *
+ * @details prints how far the burst guesses were off on average, only with a burst
+ *          prediction weight
+ * @param processors
+ * @param blocks
+ */
+void SrtfPolicy::report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks){
+	chrono::nanoseconds error(0);
+	int bursts = 0;
+	if (config->getBurstWeight() == 0){
+		return;
+	}
+	for (const ProcessControlBlock &block : blocks){
+		error += stateOf<SrtfState>(&block)->predictionError;
+		bursts += stateOf<SrtfState>(&block)->bursts;
+	}
+	if (bursts == 0){
+		return;
+	}
+	ostringstream line;
+	line << fixed << setprecision(3) << "OS: " << bursts << " bursts guessed with a weight of " << config->getBurstWeight() << "%, off by "
+		<< chrono::duration<double, milli>(error).count() / bursts << " ms on average";
+	OperatingSystem::logLine(timeStamp(), line.str());
+}
+
+EdfPolicy::EdfPolicy(Config *config) : PreemptivePolicy(config), admittedLoad(0), oneShotLeft(0){
+	rejectedSets = 0;
+	rejectedProcesses = 0;
+	pthread_mutex_init(&jobLock, NULL);
+}
+
+EdfPolicy::~EdfPolicy(){
+	pthread_mutex_destroy(&jobLock);
+}
+
+/**
+ * @name admit
+ *
+ * @details the deadline is set once the whole process set is admitted
+ * @param block
+ * @param begin
+ * @param timing
+ *      deadline and period from A{begin}, NULL if it has none
+ */
+void EdfPolicy::admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing){
+	EdfState *state = new EdfState();
+	state->key = chrono::nanoseconds(0);
+	state->timing = timing;
+	state->release = chrono::nanoseconds(0);
+	state->deadline = chrono::nanoseconds::max();
+	state->jobWork = chrono::nanoseconds(0);
+	state->jobs = 1;
+	state->load = 0;
+	block->state.reset(state);
+}
+
+//the time after the simulator started the process is due
+chrono::nanoseconds EdfPolicy::key(Processor &cpu, const ProcessControlBlock *block){
+	return stateOf<EdfState>(block)->deadline;
+}
+
+/**
+ * @name admitSet
+ *
+ * @details releases the first job of every process of a set, sets the deadline of the ones
+ *          that have one and checks the set fits. The share of a processor a process needs is
+ *          the time a job takes over its period, or over its deadline if it has no period. A
+ *          set that would take the processes not done yet past the processors there are is
+ *          turned away whole
+ * @param blocks
+ * @param first
+ *      first process control block of the set
+ * @param processors
+ *      how many processors there are
+ * @return
+ *      false if the set was turned away
+ */
+bool EdfPolicy::admitSet(deque<ProcessControlBlock> &blocks, size_t first, size_t processors){
+	chrono::nanoseconds now = chrono::duration_cast<chrono::nanoseconds>(Time::now() - timeInit);
+	long long load = 0;
+	int oneShot = 0;
+	for (size_t i = first; i < blocks.size(); i++){
+		EdfState *state = stateOf<EdfState>(&blocks[i]);
+		state->release = now;
+		state->jobWork = blocks[i].work;
+		if (state->timing == NULL || state->timing->period == 0){
+			oneShot++;
+		}
+		if (state->timing == NULL){
+			continue;
+		}
+		state->deadline = now + chrono::milliseconds(state->timing->deadline);
+		chrono::milliseconds interval(state->timing->period > 0 ? state->timing->period : state->timing->deadline);
+		state->load = 1000000LL * blocks[i].work.count() / chrono::duration_cast<chrono::nanoseconds>(interval).count();
+		load += state->load;
+	}
+	long long capacity = 1000000LL * processors;
+	if (admittedLoad + load <= capacity){
+		admittedLoad += load;
+		oneShotLeft += oneShot;
+		return true;
+	}
+	int count = blocks.size() - first;
+	rejectedSets++;
+	rejectedProcesses += count;
+	ostringstream line;
+	line << fixed << setprecision(3) << "OS: turning away " << count << " processes, a utilization of " << load / 1e6 << " on top of "
+		<< admittedLoad / 1e6 << " is over " << processors << " processors";
+	OperatingSystem::logLine(timeStamp(), line.str());
+	return false;
+}
+
+/**
+ * @name finish
+ *
+ * @details keeps how late the job was. A process with a period is due to come back one
+ *          period after its job was released, as long as processes without a period are left
+ *          to run, otherwise it gives back the share of the processors it was admitted with
+ * @param block
+ * @return
+ *      true if the process comes back for another job
+ */
+bool EdfPolicy::finish(ProcessControlBlock *block){
+	EdfState *state = stateOf<EdfState>(block);
+	bool again = false;
+	if (state->timing == NULL || state->timing->period == 0){
+		oneShotLeft--;
+	}
+	if (state->timing == NULL){
+		return false;
+	}
+	pthread_mutex_lock(&jobLock);
+	lateness.push_back(chrono::duration_cast<chrono::nanoseconds>(Time::now() - timeInit) - state->deadline);
+	if (state->timing->period > 0 && oneShotLeft > 0){
+		//a job that ran past its period has the next one released as soon as it is done
+		state->release += chrono::milliseconds(state->timing->period);
+		state->deadline = state->release + chrono::milliseconds(state->timing->deadline);
+		waiting.push_back(block);
+		again = true;
+	}
+	pthread_mutex_unlock(&jobLock);
+	if (!again){
+		admittedLoad -= state->load;
+	}
+	return again;
+}
+
+/**
+ * @name release
+ *
+ * @details takes a process whose next period has started and starts its next job from the
+ *          first operation after A{begin}
+ * @return
+ *      NULL if no process is due
+ */
+ProcessControlBlock *EdfPolicy::release(){
+	chrono::nanoseconds now = chrono::duration_cast<chrono::nanoseconds>(Time::now() - timeInit);
+	ProcessControlBlock *block = NULL;
+	pthread_mutex_lock(&jobLock);
+	for (size_t i = 0; i < waiting.size(); i++){
+		if (stateOf<EdfState>(waiting[i])->release <= now){
+			block = waiting[i];
+			waiting.erase(waiting.begin() + i);
+			break;
+		}
+	}
+	pthread_mutex_unlock(&jobLock);
+	if (block == NULL){
+		return NULL;
+	}
+	EdfState *state = stateOf<EdfState>(block);
+	state->jobs++;
+	block->programCounter = 1;
+	block->remaining = chrono::nanoseconds(0);
+	block->burst = chrono::nanoseconds(0);
+	block->work = state->jobWork;
+	OperatingSystem::logLine(timeStamp(), "OS: releasing job " + to_string(state->jobs) + " of process " + to_string(block->id));
+	return block;
+}
+
+//the period of a waiting process that starts first
+chrono::high_resolution_clock::time_point EdfPolicy::nextRelease(const chrono::high_resolution_clock::time_point until){
+	chrono::high_resolution_clock::time_point next = until;
+	pthread_mutex_lock(&jobLock);
+	for (ProcessControlBlock *block : waiting){
+		next = min(next, timeInit + chrono::duration_cast<chrono::high_resolution_clock::duration>(stateOf<EdfState>(block)->release));
+	}
+	pthread_mutex_unlock(&jobLock);
+	return next;
+}
+
+/**
+ * @name report
+ *
+ * @details prints how many jobs missed their deadline and percentiles of how late they
+ *          finished, a negative lateness is a job that finished early
+ * @param processors
+ * @param blocks
+ */
+void EdfPolicy::report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks){
+	vector<double> late;
+	int timed = 0;
+	int missed = 0;
+	for (const ProcessControlBlock &block : blocks){
+		if (stateOf<EdfState>(&block)->timing != NULL){
+			timed++;
+		}
+	}
+	for (chrono::nanoseconds job : lateness){
+		late.push_back(chrono::duration<double, milli>(job).count());
+		if (job.count() > 0){
+			missed++;
+		}
+	}
+	double stamp = timeStamp();
+	OperatingSystem::logLine(stamp, "OS: " + to_string(timed) + " processes had a deadline over " + to_string(late.size()) + " jobs, " + to_string(missed)
+		+ " jobs missed it, " + to_string(rejectedProcesses) + " processes in " + to_string(rejectedSets) + " sets were turned away");
+	if (late.empty()){
+		return;
+	}
+	sort(late.begin(), late.end());
+	//nearest rank, the lateness at least that percent of the jobs were within
+	auto percentile = [&late](int percent){
+		return late[(late.size() * percent + 99) / 100 - 1];
+	};
+	ostringstream line;
+	line << fixed << setprecision(3) << "OS: lateness 50th percentile " << percentile(50) << " ms, 90th " << percentile(90) << " ms, 99th "
+		<< percentile(99) << " ms, worst " << late.back() << " ms";
+	OperatingSystem::logLine(stamp, line.str());
+}
@@ -0,0 +1,267 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file schedulerPolicy.h
+ *
+ * @brief header file for the scheduling policies run by the processors
+ *
+ * @details every processor runs the same loop for RR, MLFQ, CFS, STRIDE, LOTTERY, SRTF and
+ *          EDF. The policy of the scheduling code decides where a ready process is queued,
+ *          which one runs next, when the running one is preempted and what is printed at the
+ *          end. RR and MLFQ queue processes in lock free rings, the others keep them in a
+ *          tree or a lottery under the lock of the processor. What a policy keeps for each
+ *          process is its own state, given to the process when it is admitted
+ *
+ */
+#ifndef SCHEDULERPOLICY_H
+#define SCHEDULERPOLICY_H
+
+#include "OperatingSystem.h"
+
+using namespace std;
+
+//MLFQ, the level a process waits in
+struct MlfqState : public PolicyState
+{
+    int level;
+};
+
+//what the tree of a processor sorts by, lowest first
+struct TreeState : public PolicyState
+{
+    chrono::nanoseconds key;
+};
+
+//CFS, STRIDE and LOTTERY share of a process
+struct FairShareState : public TreeState
+{
+    int weight; //CFS weight of the nice value, the tickets under STRIDE and LOTTERY
+    chrono::nanoseconds vruntime; //processor time scaled by the weight, the pass under STRIDE
+    double fairTime; //processor time in seconds an exactly fair processor would have given it
+    double readyClock; //fair clock when the process was last queued
+};
+
+//CFS, the weight comes from a nice value
+struct NiceState : public FairShareState
+{
+    int nice; //from the A{begin} cycles, 0 to 19
+};
+
+//LOTTERY, the tickets the process is drawn with
+struct LotteryState : public FairShareState
+{
+    long long tickets; //more than its weight after it gave up part of a quantum
+};
+
+//SRTF burst guesses
+struct SrtfState : public TreeState
+{
+    chrono::nanoseconds predicted; //guess of how long the current burst is
+    chrono::nanoseconds predictionError; //how far the guesses were off, added up
+    int bursts; //bursts that were guessed
+};
+
+//EDF deadline of a process, a process with a period runs one job every period
+struct EdfState : public TreeState
+{
+    const ProcessTiming *timing; //deadline and period from A{begin}, NULL if it has none
+    chrono::nanoseconds release; //time after the simulator started the current job was released
+    chrono::nanoseconds deadline; //time after the simulator started the current job is due, max if none
+    chrono::nanoseconds jobWork; //time the operations of one job take
+    int jobs; //jobs released so far
+    long long load; //millionths of a processor the process was admitted with
+};
+
+class SchedulerPolicy
+{
+public:
+    SchedulerPolicy(Config *config);
+    virtual ~SchedulerPolicy();
+    //policy for a CPU Scheduling Code, NULL if the processors do not run it
+    static SchedulerPolicy *create(const string &code, Config *config);
+    //levels of every ready queue
+    virtual int levels() const;
+    //level a process waits in
+    virtual int level(const ProcessControlBlock *block) const;
+    //sets up what only this policy keeps on a processor
+    virtual void addProcessor(Processor &cpu, size_t capacity);
+    //gives a new process the state of the policy, timing is NULL if A{begin} has no deadline
+    virtual void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+    //checks the processes of a load from first on, false turns the whole set away
+    virtual bool admitSet(deque<ProcessControlBlock> &blocks, size_t first, size_t processors);
+    //queues a ready process, owner is true on the thread of the processor
+    virtual void enqueue(Processor &cpu, ProcessControlBlock *block, bool owner) = 0;
+    //takes the process to run next, NULL if none is ready
+    virtual ProcessControlBlock *pick(Processor &cpu, bool owner) = 0;
+    //takes a process from a busier processor
+    virtual ProcessControlBlock *steal(Processor &cpu, Processor &busiest) = 0;
+    //called each time the first processor looks for work
+    virtual void tick();
+    //preempt checks, around a quantum, before each operation and during a processing action
+    virtual void startQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::high_resolution_clock::time_point start);
+    virtual void startOperation(ProcessControlBlock *block, const Operation &op);
+    virtual chrono::nanoseconds runSlice(Processor &cpu, const chrono::nanoseconds slice);
+    //true if the process keeps the processor
+    virtual bool endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done);
+    //a process ran its last operation, true if it comes back later and still counts as runnable
+    virtual bool finish(ProcessControlBlock *block);
+    //takes a process that is due to come back, NULL if none is
+    virtual ProcessControlBlock *release();
+    //the earlier of until and when the next process is due to come back
+    virtual chrono::high_resolution_clock::time_point nextRelease(const chrono::high_resolution_clock::time_point until);
+    //prints what the policy measured once every process is done
+    virtual void report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks);
+protected:
+    Config *config;
+};
+
+//RR, each processor has one ring it takes the oldest process from
+class RoundRobinPolicy : public SchedulerPolicy
+{
+public:
+    RoundRobinPolicy(Config *config);
+    void enqueue(Processor &cpu, ProcessControlBlock *block, bool owner);
+    ProcessControlBlock *pick(Processor &cpu, bool owner);
+    ProcessControlBlock *steal(Processor &cpu, Processor &busiest);
+protected:
+    static void pushReady(FifoRing<ProcessControlBlock*> &ready, ProcessControlBlock *block);
+    static ProcessControlBlock *takeReady(Processor &cpu);
+    void drainInbox(Processor &cpu);
+    ProcessControlBlock *takeInbox(Processor &cpu, Processor &other);
+};
+
+//MLFQ, round robin on several levels and every process goes back to the top now and then
+class MlfqPolicy : public RoundRobinPolicy
+{
+public:
+    MlfqPolicy(Config *config);
+    int levels() const;
+    int level(const ProcessControlBlock *block) const;
+    void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+    ProcessControlBlock *pick(Processor &cpu, bool owner);
+    void tick();
+    bool endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done);
+    void report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks);
+private:
+    //bumped when a boost is due, each processor boosts its own levels once it sees it
+    atomic<int> boostEpoch;
+    chrono::high_resolution_clock::time_point boostTime;
+    void boostLevels(Processor &cpu);
+};
+
+//policies that keep ready processes in the tree of the processor, sorted by key
+class TreePolicy : public SchedulerPolicy
+{
+public:
+    TreePolicy(Config *config);
+    void enqueue(Processor &cpu, ProcessControlBlock *block, bool owner);
+    ProcessControlBlock *pick(Processor &cpu, bool owner);
+    ProcessControlBlock *steal(Processor &cpu, Processor &busiest);
+protected:
+    //sets the key of a process being queued, under the lock
+    virtual void place(Processor &cpu, ProcessControlBlock *block) = 0;
+    //adds a queued process and takes the next one out, under the lock
+    virtual void insert(Processor &cpu, ProcessControlBlock *block);
+    virtual ProcessControlBlock *take(Processor &cpu);
+    //a process was taken out to run, under the lock
+    virtual void taken(Processor &cpu, ProcessControlBlock *block);
+};
+
+//CFS, runs the process that has had the least processor time for its weight
+class FairSharePolicy : public TreePolicy
+{
+public:
+    FairSharePolicy(Config *config);
+    void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+    ProcessControlBlock *steal(Processor &cpu, Processor &busiest);
+    bool endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done);
+    void report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks);
+protected:
+    void place(Processor &cpu, ProcessControlBlock *block);
+    void taken(Processor &cpu, ProcessControlBlock *block);
+    //sets up the share every kind of fair share state has
+    static void admitShare(FairShareState *state, int weight);
+    //what is printed for the share of a process
+    virtual string shareLine(const ProcessControlBlock &block, double fairness) const;
+};
+
+//STRIDE, CFS with tickets for weights, the virtual runtime is the pass
+class StridePolicy : public FairSharePolicy
+{
+public:
+    StridePolicy(Config *config);
+    void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+protected:
+    string shareLine(const ProcessControlBlock &block, double fairness) const;
+};
+
+//LOTTERY, tickets like STRIDE but the process to run is drawn at random
+class LotteryPolicy : public StridePolicy
+{
+public:
+    LotteryPolicy(Config *config);
+    void addProcessor(Processor &cpu, size_t capacity);
+    void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+    bool endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done);
+protected:
+    void insert(Processor &cpu, ProcessControlBlock *block);
+    ProcessControlBlock *take(Processor &cpu);
+};
+
+//policies that take the processor from a running process for a queued one that goes first
+class PreemptivePolicy : public TreePolicy
+{
+public:
+    PreemptivePolicy(Config *config);
+    void startQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::high_resolution_clock::time_point start);
+    chrono::nanoseconds runSlice(Processor &cpu, const chrono::nanoseconds slice);
+    bool endQuantum(Processor &cpu, ProcessControlBlock *block, const chrono::nanoseconds ran, bool done);
+protected:
+    void place(Processor &cpu, ProcessControlBlock *block);
+    //what processes are ordered by, lowest first
+    virtual chrono::nanoseconds key(Processor &cpu, const ProcessControlBlock *block) = 0;
+    //key of the running process as of now
+    virtual chrono::nanoseconds runningKey(Processor &cpu);
+};
+
+//SRTF, runs the process with the least time left
+class SrtfPolicy : public PreemptivePolicy
+{
+public:
+    SrtfPolicy(Config *config);
+    void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+    void startOperation(ProcessControlBlock *block, const Operation &op);
+    void report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks);
+protected:
+    chrono::nanoseconds key(Processor &cpu, const ProcessControlBlock *block);
+    chrono::nanoseconds runningKey(Processor &cpu);
+};
+
+//EDF, runs the process with the earliest deadline and turns away sets that do not fit
+class EdfPolicy : public PreemptivePolicy
+{
+public:
+    EdfPolicy(Config *config);
+    ~EdfPolicy();
+    void admit(ProcessControlBlock *block, const Operation &begin, const ProcessTiming *timing);
+    bool admitSet(deque<ProcessControlBlock> &blocks, size_t first, size_t processors);
+    bool finish(ProcessControlBlock *block);
+    ProcessControlBlock *release();
+    chrono::high_resolution_clock::time_point nextRelease(const chrono::high_resolution_clock::time_point until);
+    void report(const deque<Processor> &processors, const deque<ProcessControlBlock> &blocks);
+protected:
+    chrono::nanoseconds key(Processor &cpu, const ProcessControlBlock *block);
+private:
+    //millionths of the processors taken by processes that are not done
+    atomic<long long> admittedLoad;
+    int rejectedSets;
+    int rejectedProcesses;
+    //processes without a period that are not done, periodic ones come back while there are any
+    atomic<int> oneShotLeft;
+    //guards the jobs waiting for their period and the lateness of every job
+    pthread_mutex_t jobLock;
+    vector<ProcessControlBlock*> waiting;
+    vector<chrono::nanoseconds> lateness; //how long after its deadline each job finished, negative if before
+};
+
+#endif // !SCHEDULERPOLICY_H
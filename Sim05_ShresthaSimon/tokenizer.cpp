@@ -0,0 +1,166 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file tokenizer.cpp
+ *
+ * @brief implementation file for metadata tokenizer class
+ *
+ * @details each block is turned into a 32 bit mask with one bit per delimiter, the bits are
+ *          then handed out one at a time so the text between them can be used as a token
+ *
+ */
+#include <string>
+#include <cstring>
+#include <stdint.h>
+
+#include "tokenizer.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TOKENIZER_X86
+#endif
+using namespace std;
+
+// checks one byte
+static inline bool isDelimiter(char c) {
+    return c == ';' || c == '.' || c == '{' || c == '}' || c == '\n';
+}
+
+// checks a block one byte at a time
+static uint32_t scalarMask(const char *block) {
+    uint32_t mask = 0;
+    for(int i = 0; i < Tokenizer::BLOCK_SIZE; i++){
+        if(isDelimiter(block[i])){
+            mask |= (uint32_t) 1 << i;
+        }
+    }
+    return mask;
+}
+
+#ifdef TOKENIZER_X86
+// checks a block as two 16 byte halves
+__attribute__((target("sse2")))
+static uint32_t sse2Mask(const char *block) {
+    uint32_t mask = 0;
+    for(int half = 0; half < 2; half++){
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + half * 16));
+        __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(';')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('.'))),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('{')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('}'))));
+        found = _mm_or_si128(found, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+        mask |= (uint32_t) _mm_movemask_epi8(found) << (half * 16);
+    }
+    return mask;
+}
+
+// checks the whole block at once
+__attribute__((target("avx2")))
+static uint32_t avx2Mask(const char *block) {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i found = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(';')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('.'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('}'))));
+    found = _mm256_or_si256(found, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+    return (uint32_t) _mm256_movemask_epi8(found);
+}
+#endif
+
+typedef uint32_t (*MaskFunction)(const char*);
+
+// picks the fastest version the processor supports
+static MaskFunction chooseMask() {
+#ifdef TOKENIZER_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        return avx2Mask;
+    }
+    if(__builtin_cpu_supports("sse2")){
+        return sse2Mask;
+    }
+#endif
+    return scalarMask;
+}
+
+static MaskFunction blockMask = chooseMask();
+
+/**
+ * @details: sets up the tokenizer over the text, nothing is copied
+ * @param begin
+ *        start of the text
+ * @param end
+ *        one past the end of the text
+ */
+Tokenizer::Tokenizer(const char *begin, const char *end) {
+    this->block = begin;
+    this->end = end;
+    this->loadBlock();
+}
+
+/**
+ * @details: finds the next delimiter
+ * @return
+ *        pointer to the delimiter, or the end of the text
+ */
+const char *Tokenizer::next() {
+    while(this->mask == 0){
+        if(this->end - this->block <= BLOCK_SIZE){
+            this->block = this->end;
+            return this->end;
+        }
+        this->block += BLOCK_SIZE;
+        this->loadBlock();
+    }
+    int bit = __builtin_ctz(this->mask);
+    // clear the lowest bit so the next call moves on
+    this->mask &= this->mask - 1;
+    return this->block + bit;
+}
+
+/**
+ * @details: loads the mask for the block, the last block of the text is copied into a
+ *           padded buffer so nothing past the end is read
+ */
+void Tokenizer::loadBlock() {
+    long remaining = this->end - this->block;
+    if(remaining >= BLOCK_SIZE){
+        this->mask = blockMask(this->block);
+    }else if(remaining > 0){
+        char padded[BLOCK_SIZE] = {0};
+        memcpy(padded, this->block, remaining);
+        this->mask = blockMask(padded);
+    }else{
+        this->mask = 0;
+    }
+}
+
+// which version was picked
+string Tokenizer::implementation() {
+#ifdef TOKENIZER_X86
+    if(blockMask == avx2Mask){
+        return "avx2";
+    }
+    if(blockMask == sse2Mask){
+        return "sse2";
+    }
+#endif
+    return "scalar";
+}
+
+// picks a version by name
+bool Tokenizer::setImplementation(const string &name) {
+#ifdef TOKENIZER_X86
+    if(name == "avx2" && __builtin_cpu_supports("avx2")){
+        blockMask = avx2Mask;
+        return true;
+    }
+    if(name == "sse2" && __builtin_cpu_supports("sse2")){
+        blockMask = sse2Mask;
+        return true;
+    }
+#endif
+    if(name == "scalar"){
+        blockMask = scalarMask;
+        return true;
+    }
+    return false;
+}
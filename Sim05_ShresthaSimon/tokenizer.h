@@ -0,0 +1,47 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file tokenizer.h
+ *
+ * @brief header for metadata tokenizer class
+ *
+ * @details finds the characters that split up the metadata grammar ( ; . { } and new lines )
+ *          32 bytes at a time. AVX2 or SSE2 is picked when the program starts depending on
+ *          what the processor supports, otherwise every byte is checked one at a time.
+ *          Sim04 and Sim05 each keep the same copy so every simulator builds from its own
+ *          folder, a change to one has to be made to the other
+ *
+ */
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <string>
+#include <stdint.h>
+using namespace std;
+
+class Tokenizer {
+    public:
+        // size of each block checked at once
+        static const int BLOCK_SIZE = 32;
+
+        Tokenizer(const char*, const char*);
+        // position of the next delimiter, the end of the text if there are none left
+        const char *next();
+        // which version is being used, avx2, sse2 or scalar
+        static string implementation();
+        // switches to another version so tests can check each one, false if the processor
+        // does not support it. Only call it while no tokenizer is in use
+        static bool setImplementation(const string&);
+
+    private:
+        // loads the bits for the next block
+        void loadBlock();
+
+        const char *block;
+        const char *end;
+        // one bit for every delimiter in the current block that has not been returned
+        uint32_t mask;
+};
+
+
+#endif // !TOKENIZER_H
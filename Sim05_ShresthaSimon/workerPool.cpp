@@ -0,0 +1,103 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file workerPool.cpp
+ *
+ * @brief implementation file for worker thread pool class
+ *
+ * @details any thread can add jobs and any worker can take them, one lock guards the queue.
+ *          Jobs are kept in the ring by value so queueing one does not allocate
+ *
+ */
+#include <vector>
+#include <pthread.h>
+
+#include "workerPool.h"
+using namespace std;
+
+/**
+ * @details: starts the worker threads
+ * @param workerCount
+ *        number of threads to keep running
+ * @param capacity
+ *        most jobs that can wait in the queue at once
+ */
+WorkerPool::WorkerPool(int workerCount, int capacity) {
+    this->jobs.resize(capacity);
+    this->head = 0;
+    this->count = 0;
+    this->stopping = false;
+    pthread_mutex_init(&this->lock, NULL);
+    pthread_cond_init(&this->notEmpty, NULL);
+    pthread_cond_init(&this->notFull, NULL);
+
+    this->workers.resize(workerCount);
+    for(int i = 0; i < workerCount; i++){
+        pthread_create(&this->workers[i], NULL, workerThread, this);
+    }
+}
+
+// stops the workers once the queue is empty, a worker calling exit() does not wait on itself
+WorkerPool::~WorkerPool() {
+    pthread_mutex_lock(&this->lock);
+    this->stopping = true;
+    pthread_cond_broadcast(&this->notEmpty);
+    pthread_mutex_unlock(&this->lock);
+
+    for(size_t i = 0; i < this->workers.size(); i++){
+        if(!pthread_equal(this->workers[i], pthread_self())){
+            pthread_join(this->workers[i], NULL);
+        }
+    }
+}
+
+/**
+ * @details: hands the routine to a worker without waiting for it
+ * @param routine
+ *        function to run, same form as a pthread start routine
+ * @param argument
+ *        passed to the routine
+ */
+void WorkerPool::submit(void *(*routine)(void*), void *argument) {
+    Job job;
+    job.routine = routine;
+    job.argument = argument;
+    this->push(job);
+}
+
+// takes jobs until the pool is stopped
+void *WorkerPool::workerThread(void *pool) {
+    WorkerPool *workerPool = static_cast<WorkerPool*>(pool);
+    Job job;
+    while(workerPool->pop(job)){
+        job.routine(job.argument);
+    }
+    return NULL;
+}
+
+void WorkerPool::push(const Job &job) {
+    pthread_mutex_lock(&this->lock);
+    while(this->count == this->jobs.size()){
+        pthread_cond_wait(&this->notFull, &this->lock);
+    }
+    this->jobs[(this->head + this->count) % this->jobs.size()] = job;
+    this->count++;
+    pthread_cond_signal(&this->notEmpty);
+    pthread_mutex_unlock(&this->lock);
+}
+
+bool WorkerPool::pop(Job &job) {
+    pthread_mutex_lock(&this->lock);
+    while(this->count == 0 && !this->stopping){
+        pthread_cond_wait(&this->notEmpty, &this->lock);
+    }
+    bool taken = this->count > 0;
+    if(taken){
+        job = this->jobs[this->head];
+        this->head = (this->head + 1) % this->jobs.size();
+        this->count--;
+        pthread_cond_signal(&this->notFull);
+    }
+    pthread_mutex_unlock(&this->lock);
+    return taken;
+}
@@ -0,0 +1,54 @@
+/**
+ * @author Simon Shrestha
+ *
+ * @file workerPool.h
+ *
+ * @brief header for worker thread pool class
+ *
+ * @details a fixed number of threads are started once and take jobs off a bounded queue, so
+ *          work that runs in the background no longer creates and joins a new thread each
+ *          time. Work the caller would wait on is cheaper to run on the caller's own thread
+ *
+ */
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <pthread.h>
+using namespace std;
+
+class WorkerPool {
+    public:
+        // starts the workers, the queue holds at most capacity jobs
+        WorkerPool(int workers, int capacity);
+        // lets the workers finish and waits for them
+        ~WorkerPool();
+        // queues the routine for a worker and returns straight away
+        void submit(void *(*routine)(void*), void *argument);
+
+    private:
+        struct Job {
+            void *(*routine)(void*);
+            void *argument;
+        };
+
+        // body of each worker thread
+        static void *workerThread(void*);
+        // adds a job, waits while the queue is full
+        void push(const Job&);
+        // takes the oldest job, waits while the queue is empty, false once stopping
+        bool pop(Job&);
+
+        vector<pthread_t> workers;
+        // ring buffer of waiting jobs
+        vector<Job> jobs;
+        size_t head;
+        size_t count;
+        bool stopping;
+        pthread_mutex_t lock;
+        pthread_cond_t notEmpty;
+        pthread_cond_t notFull;
+};
+
+
+#endif // !WORKERPOOL_H